@@ -6,6 +6,7 @@
  */
 
 //#include "tester.h"
+#include "easyVexGrids.h"
 #include "easyVexGeneral.h"
 #include "easyVexGeo.h"
 #include "easyVexEdges.h"
@@ -1,6 +1,9 @@
 #ifndef __easyVexEdges_h__
 #define __easyVexEdges_h__
 
+//Required if included on its own:
+#include "easyVexGeneral.h"
+
 /**
  * Edge struct and functions
  */
@@ -570,23 +573,90 @@ edgeStruct[] edgestructs_frompoint(const int input; const int point){
 }
 
 /**
- * Returns all edges of a polygon as edgeStructs
+ * Returns all edges of a polygon as edgeStructs.
+ * Fetches the points of the primitive once with primpoints() and pairs consecutive points.
  *
  * @param {int}	{input}   an integer that describes an input
  * @param {int}	{primnum}   primitive id (primitive number)
  */
 edgeStruct[] edgestructs_fromprim(const int input; const int primnum){
-    
-    int skip_last = primintrinsic(input, "closed", primnum)==0 ?1 :0; //if open, don't create an edge between the end points
-
     edgeStruct result[];
-    int vtxcount = primvertexcount(input, primnum);
-    for(int i = 0; i<vtxcount-skip_last; i++){
-            push( result, edgeStruct(input,vertexpoint(input, primvertex(input, primnum,i) ),vertexpoint(input, primvertex(input, primnum,(i+1)%vtxcount ) ) ) );
+    int points[] = primpoints(input, primnum);
+    int amount = len(points);
+    if(amount<2){
+        return result;
+    }
+    for(int i = 1; i<amount; i++){
+        push( result, edgeStruct(input,points[i-1],points[i]) );
+    }
+    if(primintrinsic(input, "closed", primnum)){ //if closed, connect the end points
+        push( result, edgeStruct(input,points[amount-1],points[0]) );
+    }
+    return result;
+}
+
+/**
+ * Returns all edges of an array of primitives as an int array where every two numbers describe an edge start and end point.
+ * Edges that primitives share are returned once per primitive.
+ *
+ * @param {int}	{input}   an integer that describes an input
+ * @param {int array}	{prims}   primitive ids (primitive numbers)
+ *
+ * Example: i[]@edges = edgeints_fromprims(0, expandprimgroup(0,"top"));
+ */
+int[] edgeints_fromprims(const int input; const int prims[]){
+    int result[];
+    foreach(int primnum; prims){
+        int points[] = primpoints(input, primnum);
+        int amount = len(points);
+        if(amount<2){
+            continue;
+        }
+        for(int i = 1; i<amount; i++){
+            append( result, points[i-1] );
+            append( result, points[i] );
+        }
+        if(primintrinsic(input, "closed", primnum)){ //if closed, connect the end points
+            append( result, points[amount-1] );
+            append( result, points[0] );
+        }
     }
     return result;
 }
 
+/**
+ * Returns all edges of the primitives in a primitive group as an int array where every two numbers describe an edge start and end point.
+ * Use edgeArrayStruct(input, edgeints_fromprims(input, group)) to work with the result as edges.
+ *
+ * @param {int}	{input}   an integer that describes an input
+ * @param {string}	{group}   name of a Houdini primitive group or a group pattern
+ *
+ * Example: i[]@edges = edgeints_fromprims(0, "top");
+ */
+int[] edgeints_fromprims(const int input; const string group){
+    return edgeints_fromprims(input, expandprimgroup(input, group));
+}
+
+/**
+ * Returns all edges of the geometry at input as edgeStructs. Every edge is returned once, even if primitives share it.
+ * Walks every half-edge once and only keeps the primary ones (see hedge_isprimary()).
+ * This is faster than calling edgestructs_fromprim() for every primitive and removing the duplicates with sort().
+ *
+ * @param {int}	{input}   an integer that describes an input
+ *
+ * Example: printf(getfullname( edgestructs_fromgeo(0) ));
+ */
+edgeStruct[] edgestructs_fromgeo(const int input){
+	edgeStruct result[];
+	int amount = nvertices(input); //every vertex starts one half-edge
+	for(int hedge=0; hedge<amount; hedge++){
+		if( hedge_isvalid(input,hedge) && hedge_isprimary(input,hedge) ){
+			push( result, edgeStruct(input, hedge_srcpoint(input,hedge), hedge_dstpoint(input,hedge)) );
+		}
+	}
+	return result;
+}
+
 /**
  * Returns a edgeStruct array given an input and an array of point id pairs.
  *
@@ -639,6 +709,117 @@ edgeStruct[] edgestructs_fromgroup(const int input; const string name){
 	return edgestructs_fromarray(input,expandedgegroup(input, name));
 }
 
+/**
+ * Returns 1 if VEX ints are 64 bit (VEX precision 64), 0 if they are 32 bit.
+ */
+int has64bitints(){
+	int big = 2147483647;
+	big += 1;
+	return big>0;
+}
+
+/**
+ * Returns one int key per edge. Two edges get the same key if they have the same points, no matter their direction.
+ * Sorting by the keys sorts the edges by their smaller point (primary) and their bigger point (secondary).
+ * The key is min(a,b)*N+max(a,b), with N one more than the biggest point number.
+ * If that could overflow a 32-bit int, the edges are ranked instead (with two stable argsorts). 
+ * In that case the sorted order is a by-product and is written into order, so argsort(keys) is not needed.
+ * Otherwise order is empty.
+ *
+ * @param {edgeStruct array}	{edges}   an array of edgeStructs
+ * @param {int array}	{order}   a variable that is passed by reference. It will contain argsort(keys) if the keys were ranked, otherwise it is empty.
+ * 
+ * Example: 
+ * int order[];
+ * i[]@keys = edgekeys(edges, order);
+ */
+int[] edgekeys(const edgeStruct edges[]; int order[]){
+	int amount = len(edges);
+	int lo[], hi[], keys[];
+	resize(order, 0);
+	resize(lo, amount);
+	resize(hi, amount);
+	resize(keys, amount);
+	if(amount==0){
+		return keys;
+	}
+	foreach(int i; edgeStruct ed; edges){
+		lo[i] = min( pointa(ed), pointb(ed) );
+		hi[i] = max( pointa(ed), pointb(ed) );
+	}
+	int base = max(hi)+1;
+	if( base<=46340 || has64bitints() ){ //46340*46340 still fits into a 32-bit int
+		for(int i=0; i<amount; i++){
+			keys[i] = lo[i]*base + hi[i];
+		}
+		return keys;
+	}
+	//First we sort by hi, then by lo. The order of hi is preserved for identical lo values.
+	order = argsort(hi);
+	order = reorder( order, argsort( reorder(lo, order) ) );
+	int rank = -1;
+	int previouslo = 0;
+	int previoushi = 0;
+	foreach(int index; order){
+		if(rank<0 || lo[index]!=previouslo || hi[index]!=previoushi){
+			rank++;
+			previouslo = lo[index];
+			previoushi = hi[index];
+		}
+		keys[index] = rank;
+	}
+	return keys;
+}
+
+/**
+ * Returns one int key per edge. Two edges get the same key if they have the same points, no matter their direction.
+ * See edgekeys(edges, order).
+ *
+ * @param {edgeStruct array}	{edges}   an array of edgeStructs
+ * 
+ * Example: i[]@keys = edgekeys(edges);
+ */
+int[] edgekeys(const edgeStruct edges[]){
+	int order[];
+	return edgekeys(edges, order);
+}
+
+/**
+ * Returns an array of edgeStructs, sorted by a (primary) and b (secondary) in increasing order.
+ * Every edge is flipped so that a<b and keeps its own input.
+ * The edges are sorted with a single argsort on edgekeys(), or none if edgekeys() already sorted them.
+ *
+ * @param {edgeStruct array}	{edges}   an array of edgeStructs
+ * @param {int}	{unique}   if 1, edges with the same points (in any direction) and the same input are only returned once (the first one of them)
+ * 
+ * Example: printf(getfullname( sort(edges,1) ));
+ */
+edgeStruct[] sort(const edgeStruct edges[]; const int unique){
+	edgeStruct result[];
+	int order[];
+	int keys[] = edgekeys(edges, order);
+	if(len(order)==0){
+		order = argsort(keys);
+	}
+	int groupinputs[]; //inputs already returned for the current key
+	foreach(int i; int index; order){
+		int input = input(edges[index]);
+		if(unique){
+			if( i>0 && keys[index]==keys[order[i-1]] ){ //same points as the previous edge
+				if( find(groupinputs, input)>=0 ){
+					continue;
+				}
+			}
+			else{
+				resize(groupinputs, 0);
+			}
+			append(groupinputs, input);
+		}
+		push( result, sort(edges[index]) );
+	}
+	return result;
+}
+
 /**
  * Returns an array of edgeStructs, sorted by a (primary) and b (secondary) in increasing order
  *
@@ -647,37 +828,388 @@ edgeStruct[] edgestructs_fromgroup(const int input; const string name){
  * Example: printf(getfullname( sort(edges) ));
  */
 edgeStruct[] sort(const edgeStruct edges[]){
-	int amount;
+	return sort(edges, 0);
+}
+
+/**
+ * Returns new array of edges that does not contain any of the edges in remove (in either direction).
+ * All edges are compared by edgekeys() and a sorted merge, so this takes O(n log n) instead of 
+ * calling removevalue() for every edge in remove.
+ *
+ * @param {edgeStruct array}	{edges}   an array of edgeStructs
+ * @param {edgeStruct array}	{remove}   an array of edgeStructs that should be removed from edges
+ * 
+ * Example: printf(getfullname( removevalues(edges, edgestructs_fromgroup(0,"seams")) ));
+ */
+edgeStruct[] removevalues(const edgeStruct edges[]; const edgeStruct remove[]){
 	edgeStruct result[];
-	int alla[], allb[], ordera[], orderb[];
-	//split the edges into front points and rear points
-	foreach(edgeStruct ed; edges){
-		if(pointa(ed)<pointb(ed)){
-			append( alla, pointa(ed) );
-			append( allb, pointb(ed) );
+	int amount = len(edges);
+	edgeStruct all[] = edges;
+	push(all, remove);
+	int keys[] = edgekeys(all); //computed together, so both arrays share the same keys
+	int found[] = containsvalues( keys[0:amount], keys[amount:] );
+	foreach(int i; edgeStruct ed; edges){
+		if(!found[i]){
+			push(result, ed);
 		}
-		else{
-			append( alla, pointb(ed) );
-			append( allb, pointa(ed) );
+	}
+	return result;
+}
+
+/**
+ * Returns new array of all edges that are in edges1 or edges2 (in either direction). Every edge is only returned once.
+ * The edges of edges1 come first, then the new edges of edges2. Every edge keeps the direction of its first occurrence.
+ *
+ * @param {edgeStruct array}	{edges1}   an array of edgeStructs
+ * @param {edgeStruct array}	{edges2}   an array of edgeStructs
+ * 
+ * Example: printf(getfullname( edgeunion(edges1, edges2) ));
+ */
+edgeStruct[] edgeunion(const edgeStruct edges1[]; const edgeStruct edges2[]){
+	edgeStruct result[];
+	edgeStruct all[] = edges1;
+	push(all, edges2);
+	int first[] = firstvalues( edgekeys(all) );
+	foreach(int i; edgeStruct ed; all){
+		if(first[i]){
+			push(result, ed);
 		}
 	}
-	//Determine order
-	//First we sort by b, then by a. 
-	//The order of a overrides the previous sorting, but the b order is naturally preserved for identical a values.
-	orderb = argsort(allb);
-	alla = reorder(alla, orderb);
-	allb = reorder(allb, orderb);
+	return result;
+}
 
-	ordera = argsort(alla);
-	alla = reorder(alla, ordera);
-	allb = reorder(allb, ordera);
+/**
+ * Returns new array of all edges of edges1 that are also in edges2 (in either direction). Every edge is only returned once.
+ *
+ * @param {edgeStruct array}	{edges1}   an array of edgeStructs
+ * @param {edgeStruct array}	{edges2}   an array of edgeStructs
+ * 
+ * Example: printf(getfullname( edgeintersection(edges1, edges2) ));
+ */
+edgeStruct[] edgeintersection(const edgeStruct edges1[]; const edgeStruct edges2[]){
+	edgeStruct result[];
+	int amount = len(edges1);
+	edgeStruct all[] = edges1;
+	push(all, edges2);
+	int keys[] = edgekeys(all);
+	int keys1[] = keys[0:amount];
+	int found[] = containsvalues( keys1, keys[amount:] );
+	int first[] = firstvalues( keys1 );
+	foreach(int i; edgeStruct ed; edges1){
+		if(found[i] && first[i]){
+			push(result, ed);
+		}
+	}
+	return result;
+}
 
-	amount = len(alla);
-	edgeStruct temp;
+/**
+ * Returns an island id for every edge. Edges that are connected through shared points get the same id.
+ * The ids go from 0 to the amount of islands-1, in the order the islands first appear in edges.
+ * The points are relabeled densely with denselabels() first, so the disjointSetStruct only holds the points of the edges 
+ * and the cost depends on the amount of edges (O(E log E)), not on the biggest point number.
+ *
+ * @param {edgeStruct array}	{edges}   an array of edgeStructs
+ * 
+ * Example: i[]@islands = edgeislands( edgestructs_fromgroup(0,"cables") );
+ */
+int[] edgeislands(const edgeStruct edges[]){
+	int result[];
+	int amount = len(edges);
+	resize(result, amount);
+	if(amount==0){
+		return result;
+	}
+	int pointids[];
+	int points[] = denselabels(getints(edges), pointids); //points of edge i are points[2*i] and points[2*i+1]
+	disjointSetStruct sets = disjointSetStruct( len(pointids) );
+	for(int i=0; i<amount; i++){
+		unite(sets, points[2*i], points[2*i+1] );
+	}
+	//number the islands in the order of the edges
+	int ids[];
+	resize(ids, len(pointids));
+	int count = 0;
 	for(int i=0; i<amount; i++){
-		temp = edgeStruct(input(edges[0]),alla[i],allb[i]); //!!!!INPUT Could BE FIXED
-		push(result, temp);
+		int root = findroot(sets, points[2*i]);
+		if(ids[root]==0){ //ids are stored +1, so 0 means not assigned yet
+			count++;
+			ids[root] = count;
+		}
+		result[i] = ids[root]-1;
+	}
+	return result;
+}
+
+/**
+ * Sorts an unordered array of edges into chains of points and returns the points of all chains, one chain after the other.
+ * The points of chain i are result[offsets[i]] to result[offsets[i+1]-1].
+ * A chain ends at points that do not have exactly two edges (ends and branches). 
+ * A closed chain (a loop) does not repeat its first point at the end.
+ * Relabels the points densely with denselabels() and builds the point to edge connections once, 
+ * so this takes O(E log E), no matter how big the point numbers are.
+ *
+ * @param {edgeStruct array}	{edges}   an array of edgeStructs
+ * @param {int array}	{offsets}   a variable that is passed by reference. Start of every chain in the result, followed by len(result).
+ * @param {int array}	{closed}   a variable that is passed by reference. 1 for every chain that is closed, otherwise 0.
+ * 
+ * Example:
+ * int offsets[], closed[];
+ * int chains[] = edgechains( edgestructs_fromgroup(0,"seams"), offsets, closed );
+ * int firstchain[] = chains[offsets[0]:offsets[1]];
+ */
+int[] edgechains(const edgeStruct edges[]; int offsets[]; int closed[]){
+	int result[];
+	resize(offsets, 0);
+	resize(closed, 0);
+	int amount = len(edges);
+	if(amount==0){
+		append(offsets, 0);
+		return result;
+	}
+	//relabel the points to 0..size-1, so the tables below only hold the points of the edges
+	int pointids[];
+	int points[] = denselabels(getints(edges), pointids); //points of edge i are points[2*i] and points[2*i+1]
+	int size = len(pointids);
+
+	//edges of point label pt are edgeids[starts[pt]] to edgeids[starts[pt+1]-1]
+	int starts[];
+	resize(starts, size+1);
+	foreach(int pt; points){
+		starts[pt+1] += 1;
+	}
+	for(int pt=0; pt<size; pt++){
+		starts[pt+1] += starts[pt];
+	}
+	int fill[] = starts[0:size];
+	int edgeids[];
+	resize(edgeids, 2*amount);
+	foreach(int i; int pt; points){
+		edgeids[fill[pt]] = i/2;
+		fill[pt] += 1;
+	}
+
+	int visited[];
+	resize(visited, amount);
+	//first pass: chains that start at ends and branches, seccond pass: the remaining loops
+	for(int pass=0; pass<2; pass++){
+		for(int start=0; start<size; start++){
+			int degree = starts[start+1]-starts[start];
+			if( degree==0 || (pass==0 && degree==2) ){
+				continue;
+			}
+			for(int slot=starts[start]; slot<starts[start+1]; slot++){
+				int edge = edgeids[slot];
+				if(visited[edge]){
+					continue;
+				}
+				append(offsets, len(result));
+				append(result, pointids[start]);
+				int current = start;
+				int isclosed = 0;
+				while(edge>=0){
+					visited[edge] = 1;
+					int next = points[2*edge]==current ? points[2*edge+1] : points[2*edge];
+					if(next==start){
+						isclosed = 1;
+						break;
+					}
+					append(result, pointids[next]);
+					current = next;
+					edge = -1;
+					if(starts[next+1]-starts[next]!=2){ //end or branch
+						break;
+					}
+					for(int other=starts[next]; other<starts[next+1]; other++){
+						if(!visited[edgeids[other]]){
+							edge = edgeids[other];
+						}
+					}
+				}
+				append(closed, isclosed);
+			}
+		}
+	}
+	append(offsets, len(result));
+	return result;
+}
+
+/**
+ * Returns the point that continues an edge loop from point s through point d, or -1 if the loop ends at d.
+ * The loop continues if d has exactly four neighbours and two faces next to the edge: 
+ * then it goes to the neighbour that does not share a face with the edge.
+ *
+ * @param {int}	{input}   an integer that describes an input
+ * @param {int}	{s}   the point the loop comes from
+ * @param {int}	{d}   the point the loop arrives at
+ */
+int edgeloop_next(const int input; const int s,d){
+	int nbs[] = neighbours(input,d);
+	if(len(nbs)!=4){ //pole or boundary
+		return -1;
+	}
+	int start = pointedge(input,s,d);
+	if(start<0){
+		return -1;
+	}
+	//remove s and the points that share a face with the edge
+	removevalue(nbs,s);
+	int hedge = start;
+	do{
+		int side = hedge_dstpoint(input,hedge)==d ? hedge_dstpoint(input, hedge_next(input,hedge)) : hedge_srcpoint(input, hedge_prev(input,hedge));
+		removevalue(nbs,side);
+		hedge = hedge_nextequiv(input,hedge);
+	} while(hedge!=start && hedge>=0);
+	return len(nbs)==1 ? nbs[0] : -1;
+}
+
+/**
+ * Returns the edge loop through an edge as an array of edgeStructs in loop order. All edges point along the loop.
+ * The loop runs through points with four neighbours (quad-dominant meshes) and stops at poles, boundaries or when it closes.
+ * Visited edges are remembered in a bit array, one bit per half-edge.
+ *
+ * @param {edgeStruct}	{seed}   an edgeStruct that is part of the loop
+ * 
+ * Example: printf(getfullname( edgeloop(edgeStruct(0,1)) ));
+ */
+edgeStruct[] edgeloop(const edgeStruct seed){
+	int input = input(seed);
+	edgeStruct forward[], backward[];
+	int visited[] = bitarray( nvertices(input) );
+	int seedhedge = pointedge(seed);
+	if(seedhedge<0){
+		warning("edgeloop: %s is not an edge at input %i.", getfullname(seed), input);
+		return forward;
+	}
+	setbit(visited, hedge_primary(input,seedhedge) );
+	push(forward, seed);
+	for(int direction=0; direction<2; direction++){
+		int s = direction==0 ? pointa(seed) : pointb(seed);
+		int d = direction==0 ? pointb(seed) : pointa(seed);
+		while(1){
+			int next = edgeloop_next(input,s,d);
+			if(next<0){
+				break;
+			}
+			int hedge = hedge_primary(input, pointedge(input,d,next) );
+			if(getbit(visited,hedge)){ //closed loop
+				break;
+			}
+			setbit(visited,hedge);
+			if(direction==0){
+				push(forward, edgeStruct(input,d,next) );
+			}
+			else{
+				push(backward, edgeStruct(input,next,d) );
+			}
+			s = d;
+			d = next;
+		}
+	}
+	edgeStruct result[];
+	for(int i=len(backward)-1; i>=0; i--){
+		push(result, backward[i]);
+	}
+	push(result, forward);
+	return result;
+}
+
+/**
+ * Returns the next edge of an edge ring. Returns 0 if the ring ends.
+ * The ring crosses the face next to edge p-q that is not fromprim. The face has to be a quad.
+ * At the start (fromprim -1) the first quad next to the edge is crossed, faces that are not quads are skipped.
+ * The next edge is the opposite edge in that face (np is across from p, nq is across from q).
+ *
+ * @param {int}	{input}   an integer that describes an input
+ * @param {int}	{p}   a point of the current edge
+ * @param {int}	{q}   a point of the current edge
+ * @param {int}	{fromprim}   the face the ring comes from, -1 at the start
+ * @param {int}	{np}   a variable that is passed by reference. Point of the next edge across from p
+ * @param {int}	{nq}   a variable that is passed by reference. Point of the next edge across from q
+ * @param {int}	{nprim}   a variable that is passed by reference. The face that was crossed
+ */
+int edgering_next(const int input; const int p,q,fromprim; int np,nq,nprim){
+	int start = pointedge(input,p,q);
+	if(start<0){
+		return 0;
+	}
+	int hedge = start;
+	do{
+		int prim = hedge_prim(input,hedge);
+		if(prim!=fromprim){
+			if(primvertexcount(input,prim)==4){
+				int opposite = hedge_next(input, hedge_next(input,hedge) );
+				//the opposite half-edge runs the other way
+				int forward = hedge_srcpoint(input,hedge)==p;
+				np = forward ? hedge_dstpoint(input,opposite) : hedge_srcpoint(input,opposite);
+				nq = forward ? hedge_srcpoint(input,opposite) : hedge_dstpoint(input,opposite);
+				nprim = prim;
+				return 1;
+			}
+			if(fromprim>=0){ //the ring arrived at a face it can not cross
+				return 0;
+			}
+			//at the start the other face of the edge may still be a quad
+		}
+		hedge = hedge_nextequiv(input,hedge);
+	} while(hedge!=start && hedge>=0);
+	return 0;
+}
+
+/**
+ * Returns the edge ring through an edge as an array of edgeStructs in ring order. All edges point in the direction of the seed.
+ * The ring crosses quads and stops at other faces, boundaries or when it closes.
+ * Visited edges are remembered in a bit array, one bit per half-edge.
+ *
+ * @param {edgeStruct}	{seed}   an edgeStruct that is part of the ring
+ * 
+ * Example: printf(getfullname( edgering(edgeStruct(0,1)) ));
+ */
+edgeStruct[] edgering(const edgeStruct seed){
+	int input = input(seed);
+	edgeStruct forward[], backward[];
+	int visited[] = bitarray( nvertices(input) );
+	int seedhedge = pointedge(seed);
+	if(seedhedge<0){
+		warning("edgering: %s is not an edge at input %i.", getfullname(seed), input);
+		return forward;
+	}
+	setbit(visited, hedge_primary(input,seedhedge) );
+	push(forward, seed);
+	int firstprim = -1; //quad crossed by the first step, the seccond direction tries the remaining face
+	for(int direction=0; direction<2; direction++){
+		int p = pointa(seed);
+		int q = pointb(seed);
+		int fromprim = firstprim;
+		int np,nq,nprim;
+		if(direction==1 && firstprim<0){ //the first direction did not find a face
+			break;
+		}
+		while( edgering_next(input,p,q,fromprim,np,nq,nprim) ){
+			if(direction==0 && firstprim<0){
+				firstprim = nprim;
+			}
+			int hedge = hedge_primary(input, pointedge(input,np,nq) );
+			if(getbit(visited,hedge)){ //closed ring
+				break;
+			}
+			setbit(visited,hedge);
+			if(direction==0){
+				push(forward, edgeStruct(input,np,nq) );
+			}
+			else{
+				push(backward, edgeStruct(input,np,nq) );
+			}
+			p = np;
+			q = nq;
+			fromprim = nprim;
+		}
+	}
+	edgeStruct result[];
+	for(int i=len(backward)-1; i>=0; i--){
+		push(result, backward[i]);
 	}
+	push(result, forward);
 	return result;
 }
 
@@ -873,21 +1405,13 @@ float angle_d(const int input1 ; const edgeStruct ed1 ;const int input2;  const
 
 /**
  * Returns angle between two edges in radians around a rotation axis 
+ *
+ * @param {edgeStruct}	{ed1}   an edgeStruct 
+ * @param {edgeStruct}	{ed2}   an edgeStruct 
+ * @param {vector}	{axis}	rotation axis around which we measure the angle
  */
 float angle_around(const edgeStruct ed1,ed2; vector axis){
-    vector a = vectorab_n(ed1); 
-    vector b = vectorab_n(ed2); 
-    vector world_up = set(0,1,0);
-    if(axis!= world_up ){ //rotate to align up axis to y
-        //in a more generic context the following might be useful as it's own function, it's a common operation.
-        vector4 q_align = dihedral(world_up, axis);
-        vector at = vectorab_n(ed1);
-        a = qrotate(q_align, a); 
-        b = qrotate(q_align, b); 
-    }
-    vector4 q_align = dihedral(a, set(0,0,-1) ); //this rotates the vectors to align against the z axis, the atan2 function is zero for this
-    b = qrotate(q_align, b); 
-    return atan2( b.x, b.z);
+    return angle_around( vectorab(ed1), vectorab(ed2), axis);
 }
 
 
@@ -902,4 +1426,1046 @@ float angle_around_d(const edgeStruct ed1,ed2; vector axis){
     return degrees(angle_around( ed1,ed2, axis));
 }
 
+/**
+ * Returns all edges connected to a point at input, sorted counterclockwise around axis.
+ * The first edge is the one to neighbours(input,ptnum)[0], all others follow by their angle to it.
+ * Each edge points away from the point, so pointa() is always ptnum.
+ *
+ * @param {int}	{input}   an integer that describes an input
+ * @param {int}	{ptnum}   an integer that describes a point number
+ * @param {vector}	{axis}	rotation axis, usually the point normal
+ * 
+ * Example: edgeStruct fan[] = onering_sorted(0, @ptnum, v@N);
+ */
+edgeStruct[] onering_sorted(const int input; const int ptnum; const vector axis){
+	edgeStruct result[] = edgestructs_frompoint(input, ptnum);
+	int amount = len(result);
+	if(amount<3){
+		return result;
+	}
+	//build the frame once: tangent towards the first neighbour, bitangent perpendicular to it
+	vector P = point(input,"P",ptnum);
+	vector n = normalize(axis);
+	vector tangent = point(input,"P",pointb(result[0])) - P;
+	tangent = normalize(tangent - n*dot(tangent,n) );
+	vector bitangent = cross(n,tangent);
+	float angles[];
+	resize(angles,amount);
+	foreach(int i; edgeStruct ed; result){
+		vector dir = point(input,"P",pointb(ed)) - P;
+		float angle = atan2( dot(dir,bitangent), dot(dir,tangent) );
+		angles[i] = angle<0 ? angle+2*PI : angle;
+	}
+	return reorder(result, argsort(angles));
+}
+
+/**
+ * Returns the angle in radians between the two primitives of every edge of the geometry at input. 0 means flat.
+ * Every primitive normal is computed once and every edge is visited once (primary half-edges only).
+ * Boundary edges get an angle of 0. Edges shared by more than two primitives use the first two.
+ *
+ * @param {int}	{input}   an integer that describes an input
+ * @param {int array}	{edges}   a variable that is passed by reference. It will contain every two numbers an edge start and end point, in the order of the angles.
+ *
+ * Example: int edges[]; f[]@angles = dihedralangles(0, edges);
+ */
+float[] dihedralangles(const int input; int edges[]){
+	float result[];
+	resize(edges,0);
+	int primamount = nprimitives(input);
+	vector normals[];
+	resize(normals, primamount);
+	for(int prim=0; prim<primamount; prim++){
+		normals[prim] = prim_normal(input, prim, 0.5, 0.5);
+	}
+	int amount = nvertices(input); //every vertex starts one half-edge
+	for(int hedge=0; hedge<amount; hedge++){
+		if( !hedge_isvalid(input,hedge) || !hedge_isprimary(input,hedge) ){
+			continue;
+		}
+		append(edges, hedge_srcpoint(input,hedge));
+		append(edges, hedge_dstpoint(input,hedge));
+		int other = hedge_nextequiv(input,hedge);
+		if(other==hedge){ //boundary edge
+			append(result, 0.0);
+			continue;
+		}
+		float cosine = dot( normals[hedge_prim(input,hedge)], normals[hedge_prim(input,other)] );
+		append(result, acos( clamp(cosine,-1.0,1.0) ) );
+	}
+	return result;
+}
+
+/**
+ * Adds every edge of the geometry at input whose primitives meet at more than a given angle to an edge group.
+ * Use it in a detail wrangle, the group is written to the output geometry (geohandle 0).
+ * Returns the amount of edges that were added.
+ *
+ * @param {int}	{input}   an integer that describes an input
+ * @param {string}	{group}   name of the edge group
+ * @param {float}	{threshold_d}   angle in degrees. Edges with a bigger angle are added.
+ *
+ * Example: i@sharp = dihedralgroup(0, "sharp", 30);
+ */
+int dihedralgroup(const int input; const string group; const float threshold_d){
+	int edges[];
+	float angles[] = dihedralangles(input, edges);
+	float threshold = radians(threshold_d);
+	int count = 0;
+	foreach(int i; float angle; angles){
+		if(angle>threshold){
+			setedgegroup(0, group, edges[2*i], edges[2*i+1], 1);
+			count++;
+		}
+	}
+	return count;
+}
+
+//////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////
+//Following is an edge that stores its positions (edgeGeoStruct)//
+//////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////
+
+/**
+ * \verbatim
+ * An edgeGeoStruct is an edge that fetches the positions of its points once when it is created 
+ * and stores them together with its direction and length.
+ * Use it instead of an edgeStruct when you call several position based functions on the same edge.
+ * Every edgeStruct accessor reads "P" again, an edgeGeoStruct accessor does not read the geometry at all.
+ * If the points move afterwards, the edgeGeoStruct is not updated.
+ *
+ * To create a variable of type custom struct:
+ * 	edgeGeoStruct ed1 = edgeGeoStruct(0,1,2);
+ * 	edgeGeoStruct ed2 = edgeGeoStruct( edgeStruct(1,2) );
+ *
+ * To use it:
+ * 	f@len = length(ed1);
+ * 	f@angle = angle_d(ed1,ed2);
+ * \endverbatim
+ */
+struct edgeGeoStruct{
+	int input,a,b;
+	vector A,B; //positions of point a and b
+	vector dir; //normalized vector AB
+	float length; //distance between A and B
+
+	/**
+	 * Returns the int of the input of the edge
+	 * 
+	 * Example: int input = input(ed1);
+	 */
+	int input(){
+		return this.input;
+	}
+
+	/**
+	 * Returns the int for point a of the edge
+	 * 
+	 * Example: int pt_a = pointa(ed1);
+	 */
+	int pointa(){
+		return this.a;
+	}
+
+	/**
+	 * Returns the int for point b of the edge
+	 * 
+	 * Example: int pt_b = pointb(ed1);
+	 */
+	int pointb(){
+		return this.b;
+	}
+
+	/**
+	 * Print verbose edge description to log
+	 * 
+	 * Example: printfverbose(ed1);
+	 */
+	void printfverbose(){
+		printf("edge between points %i and %i, at input %i, from %g to %g\n", this.a,this.b,this.input,this.A,this.B);
+	}
+
+	/**
+	 * Returns a string in standard Houdini edge format
+	 * 
+	 * Example: printf(getfullname(ed1));
+	 */
+	string getfullname(){
+		return sprintf("p%i_%i", this.a, this.b);
+	}
+
+	/**
+	 * Returns the stored position of the edgepoint a
+	 * 
+	 * Example: v@pos = posa(ed1);
+	 */
+	vector posa(){
+		return this.A;
+	}
+
+	/**
+	 * Returns the stored position of the edgepoint b
+	 * 
+	 * Example: v@pos = posb(ed1);
+	 */
+	vector posb(){
+		return this.B;
+	}
+
+	/**
+	 * Returns the stored length of the edge
+	 * 
+	 * Example: f@len = length(ed1);
+	 */
+	float length(){
+		return this.length;
+	}
+
+	/**
+	 * Returns the non-normalized vector AB == posB - posA
+	 * 
+	 * Example: v@vectorab = vectorab(ed1); 
+	 */
+	vector vectorab(){
+		return this.B - this.A;
+	}
+
+	/**
+	 * Returns the non-normalized vector BA == posA - posB
+	 * 
+	 * Example: v@vectorba = vectorba(ed1); 
+	 */
+	vector vectorba(){
+		return this.A - this.B;
+	}
+
+	/**
+	 * Returns the stored normalized vector AB == posB - posA
+	 * 
+	 * Example: v@vectorab = vectorab_n(ed1); 
+	 */
+	vector vectorab_n(){
+		return this.dir;
+	}
+
+	/**
+	 * Returns the normalized vector BA == posA - posB
+	 * 
+	 * Example: v@vectorba = vectorba_n(ed1);
+	 */
+	vector vectorba_n(){
+		return -this.dir;
+	}
+
+	/**
+	 * Returns the center position of the edge
+	 * 
+	 * Example: v@halfpos = posmid(ed1);
+	 */
+	vector posmid(){
+		return ( this.A + this.B )*.5;
+	}
+}
+
+/**
+ * Returns an edgeGeoStruct for the points a and b at input. Fetches both positions once.
+ *
+ * @param {int}	{input}   an integer that describes an input
+ * @param {int}	{a}   a point number
+ * @param {int}	{b}   a point number
+ */
+edgeGeoStruct edgeGeoStruct(const int input; const int a,b){
+	vector A = point(input,"P",a);
+	vector B = point(input,"P",b);
+	float dist = distance(A,B);
+	vector dir = dist>0 ? (B-A)/dist : set(0,0,0);
+	return edgeGeoStruct(input,a,b,A,B,dir,dist);
+}
+
+/**
+ * Returns an edgeGeoStruct for an edgeStruct. Fetches both positions once.
+ *
+ * @param {edgeStruct}	{edge}   an edgeStruct
+ */
+edgeGeoStruct edgeGeoStruct(const edgeStruct edge){
+	return edgeGeoStruct(input(edge),pointa(edge),pointb(edge));
+}
+
+/**
+ * Returns an edgeGeoStruct array for an edgeStruct array.
+ * If there are many edges, all positions are read once and shared between the edges.
+ *
+ * @param {edgeStruct array}	{edges}   an array of edgeStructs
+ */
+edgeGeoStruct[] edgegeostructs(const edgeStruct edges[]){
+	edgeGeoStruct result[];
+	vector positions[];
+	int positionsinput = -1; //input that positions was read from
+	foreach(edgeStruct edge; edges){
+		int input = input(edge);
+		if(input!=positionsinput && 2*len(edges)>npoints(input)){
+			positions = pointsp(input);
+			positionsinput = input;
+		}
+		if(input!=positionsinput){
+			push(result, edgeGeoStruct(edge) );
+			continue;
+		}
+		vector A = positions[pointa(edge)];
+		vector B = positions[pointb(edge)];
+		float dist = distance(A,B);
+		vector dir = dist>0 ? (B-A)/dist : set(0,0,0);
+		push(result, edgeGeoStruct(input,pointa(edge),pointb(edge),A,B,dir,dist) );
+	}
+	return result;
+}
+
+/**
+ * Returns the edgeStruct of an edgeGeoStruct (without the stored positions)
+ *
+ * @param {edgeGeoStruct}	{edge}   an edgeGeoStruct
+ */
+edgeStruct edgeStruct(const edgeGeoStruct edge){
+	return edgeStruct(input(edge),pointa(edge),pointb(edge));
+}
+
+/**
+ * Returns 1 if two given edges have the same points. Returns 0 otherwise.
+ *
+ * @param {edgeGeoStruct}	{ed1}   an edgeGeoStruct
+ * @param {edgeGeoStruct}	{ed2}   an edgeGeoStruct 
+ */
+int isequal(const edgeGeoStruct ed1,ed2){
+	return (pointa(ed1)==pointa(ed2) && pointb(ed1)==pointb(ed2) ) || (pointa(ed1)==pointb(ed2) && pointb(ed1)==pointa(ed2) );
+}
+
+/**
+ * Returns dot product of two edges (as vectors). 
+ *
+ * @param {edgeGeoStruct}	{ed1}   an edgeGeoStruct 
+ * @param {edgeGeoStruct}	{ed2}   an edgeGeoStruct
+ *  
+ * Example: f@dot = dot(ed1,ed2);
+ */
+float dot(const edgeGeoStruct ed1,ed2){
+	return dot(vectorab(ed1),vectorab(ed2));
+}
+
+/**
+ * Returns dot product of two normalized edges. 
+ *
+ * @param {edgeGeoStruct}	{ed1}   an edgeGeoStruct 
+ * @param {edgeGeoStruct}	{ed2}   an edgeGeoStruct
+ * 
+ * Example: f@dot = dot_n(ed1,ed2);
+ */
+float dot_n(const edgeGeoStruct ed1,ed2){
+	return dot(vectorab_n(ed1),vectorab_n(ed2));
+}
+
+/**
+ * Returns the angle between two edges in degrees
+ *
+ * @param {edgeGeoStruct}	{ed1}   an edgeGeoStruct 
+ * @param {edgeGeoStruct}	{ed2}   an edgeGeoStruct
+ * 
+ * Example: f@angle = angle_d(ed1,ed2);
+ */
+float angle_d(const edgeGeoStruct ed1,ed2){
+	return degrees( acos( dot_n( ed1,ed2)  ) );
+}
+
+/**
+ * Returns the angle between two edges in radians
+ *
+ * @param {edgeGeoStruct}	{ed1}   an edgeGeoStruct 
+ * @param {edgeGeoStruct}	{ed2}   an edgeGeoStruct
+ * 
+ * Example: f@angle = angle(ed1,ed2);
+ */
+float angle(const edgeGeoStruct ed1,ed2){
+	return acos( dot_n( ed1,ed2)  );
+}
+
+/**
+ * Returns angle between two edges in radians around a rotation axis 
+ *
+ * @param {edgeGeoStruct}	{ed1}   an edgeGeoStruct 
+ * @param {edgeGeoStruct}	{ed2}   an edgeGeoStruct 
+ * @param {vector}	{axis}	rotation axis around which we measure the angle
+ */
+float angle_around(const edgeGeoStruct ed1,ed2; vector axis){
+    return angle_around( vectorab_n(ed1), vectorab_n(ed2), axis);
+}
+
+/**
+ * Returns angle between two edges in degrees around a rotation axis
+ *
+ * @param {edgeGeoStruct}	{ed1}   an edgeGeoStruct 
+ * @param {edgeGeoStruct}	{ed2}   an edgeGeoStruct 
+ * @param {vector}	{axis}	rotation axis around which we measure the angle
+ */
+float angle_around_d(const edgeGeoStruct ed1,ed2; vector axis){
+    return degrees(angle_around( ed1,ed2, axis));
+}
+
+/////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////
+//Following is a structure of arrays for many edges (edgeArrayStruct)//
+/////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////
+
+/**
+ * \verbatim
+ * An edgeArrayStruct stores many edges of one input as two int arrays (a[] and b[]) instead of an array of edgeStructs.
+ * Edge i goes from point a[i] to point b[i]. The batch functions (lengths, vectorabs_n, posmids, ...) process all edges in one pass.
+ *
+ * To create a variable of type custom struct:
+ * 	edgeArrayStruct edges = edgeArrayStruct(0, "group1"); //from a Houdini edge group
+ * 	edgeArrayStruct edges = edgeArrayStruct(0, expandedgegroup(0,"group1")); //from an array of point id pairs
+ * 	edgeArrayStruct edges = edgeArrayStruct(edgestructs); //from an edgeStruct array
+ *
+ * To use it:
+ * 	f[]@lengths = lengths(edges);
+ * 	printf("edge 0 goes from %i to %i\n", edges.a[0], edges.b[0]);
+ * \endverbatim
+ */
+struct edgeArrayStruct{
+	int input; //input of all edges
+	int a[]; //first points of the edges
+	int b[]; //seccond points of the edges
+
+	/**
+	 * Returns the int of the input of the edges
+	 * 
+	 * Example: int input = input(edges);
+	 */
+	int input(){
+		return this.input;
+	}
+
+	/**
+	 * Returns the amount of edges
+	 * 
+	 * Example: int amount = nedges(edges);
+	 */
+	int nedges(){
+		return len(this.a);
+	}
+
+	/**
+	 * Returns edge i as an edgeStruct
+	 * 
+	 * @param {int}	{i}   index of the edge
+	 *
+	 * Example: edgeStruct ed1 = edge(edges,0);
+	 */
+	edgeStruct edge(const int i){
+		return edgeStruct(this.input,this.a[i],this.b[i]);
+	}
+
+	/**
+	 * Adds an edge at the end
+	 * 
+	 * @param {int}	{a}   a point number
+	 * @param {int}	{b}   a point number
+	 *
+	 * Example: addedge(edges,1,2);
+	 */
+	void addedge(const int a,b){
+		append(this.a,a);
+		append(this.b,b);
+	}
+}
+
+/**
+ * Returns an edgeArrayStruct given an input and an array of point id pairs (like the output of expandedgegroup).
+ * The pairs are split with array slices, not element by element.
+ *
+ * @param {int}	{input}   an integer that describes an input
+ * @param {int array}	{edges}   an array of integers where every two numbers describe an edge start and end point
+ */
+edgeArrayStruct edgeArrayStruct(const int input; const int edges[]){
+	int a[] = edges[0::2];
+	int b[] = edges[1::2];
+	return edgeArrayStruct(input,a,b);
+}
+
+/**
+ * Returns an edgeArrayStruct given a Houdini edge group by input and name 
+ *
+ * @param {int}	{input}   an integer that describes an input
+ * @param {string}	{name}   name of a Houdini edge group
+ */
+edgeArrayStruct edgeArrayStruct(const int input; const string name){
+	return edgeArrayStruct(input, expandedgegroup(input, name));
+}
+
+/**
+ * Returns an edgeArrayStruct with all edges of the geometry at input. Every edge is returned once, even if primitives share it.
+ * Works like edgestructs_fromgeo(), but writes straight into the two int arrays.
+ *
+ * @param {int}	{input}   an integer that describes an input
+ *
+ * Example: f[]@lengths = lengths( edgeArrayStruct(0) );
+ */
+edgeArrayStruct edgeArrayStruct(const int input){
+	int a[], b[];
+	int amount = nvertices(input); //every vertex starts one half-edge
+	for(int hedge=0; hedge<amount; hedge++){
+		if( hedge_isvalid(input,hedge) && hedge_isprimary(input,hedge) ){
+			append( a, hedge_srcpoint(input,hedge) );
+			append( b, hedge_dstpoint(input,hedge) );
+		}
+	}
+	return edgeArrayStruct(input,a,b);
+}
+
+/**
+ * Returns an edgeArrayStruct given an array of edgeStructs. The input of the first edge is used for all edges.
+ * An edgeArrayStruct has only one input, so it warns if the edges come from more than one input.
+ *
+ * @param {edgeStruct array}	{edges}   an array of edgeStructs
+ */
+edgeArrayStruct edgeArrayStruct(const edgeStruct edges[]){
+	int amount = len(edges);
+	int input = amount>0 ? input(edges[0]) : 0;
+	int mixed = 0;
+	int a[], b[];
+	resize(a,amount);
+	resize(b,amount);
+	foreach(int i; edgeStruct ed; edges){
+		a[i] = pointa(ed);
+		b[i] = pointb(ed);
+		if(input(ed)!=input){
+			mixed = 1;
+		}
+	}
+	if(mixed){
+		warning("edgeArrayStruct: the edges come from more than one input, all of them are treated as edges of input %i.", input);
+	}
+	return edgeArrayStruct(input, a, b);
+}
+
+/**
+ * Returns the edges of an edgeArrayStruct as an edgeStruct array
+ *
+ * @param {edgeArrayStruct}	{edges}   an edgeArrayStruct
+ */
+edgeStruct[] edgestructs(const edgeArrayStruct edges){
+	edgeStruct result[];
+	int input = input(edges);
+	foreach(int i; int a; edges.a){
+		push(result, edgeStruct(input,a,edges.b[i]) );
+	}
+	return result;
+}
+
+/**
+ * Returns edges as an int array of point indexes (every two numbers describe an edge start and end point)
+ *
+ * @param {edgeArrayStruct}	{edges}   an edgeArrayStruct
+ * 
+ * Example: i[]@display1=getints(edges); 
+ */
+int[] getints(const edgeArrayStruct edges){
+	int result[];
+	resize(result, 2*len(edges.a));
+	foreach(int i; int a; edges.a){
+		result[2*i] = a;
+		result[2*i+1] = edges.b[i];
+	}
+	return result;
+}
+
+/**
+ * Returns point indexes of first points of the edges
+ *
+ * @param {edgeArrayStruct}	{edges}   an edgeArrayStruct
+ */
+int[] getintsa(const edgeArrayStruct edges){
+	return edges.a;
+}
+
+/**
+ * Returns point indexes of seccond points of the edges
+ *
+ * @param {edgeArrayStruct}	{edges}   an edgeArrayStruct
+ */
+int[] getintsb(const edgeArrayStruct edges){
+	return edges.b;
+}
+
+/**
+ * Writes the positions of all first points into A and of all seccond points into B.
+ * If there are more edge points than points, all positions are read once and gathered with reorder().
+ *
+ * @param {edgeArrayStruct}	{edges}   an edgeArrayStruct
+ * @param {vector array}	{A}   a variable that is passed by reference. It will contain the positions of the first points.
+ * @param {vector array}	{B}   a variable that is passed by reference. It will contain the positions of the seccond points.
+ */
+void edgepositions(const edgeArrayStruct edges; vector A[],B[]){
+	int input = input(edges);
+	if( 2*len(edges.a)>npoints(input) ){
+		vector allpositions[] = pointsp(input);
+		A = reorder(allpositions, edges.a);
+		B = reorder(allpositions, edges.b);
+		return;
+	}
+	A = pointsp(input, edges.a);
+	B = pointsp(input, edges.b);
+}
+
+/**
+ * Returns the lengths of all edges
+ *
+ * @param {edgeArrayStruct}	{edges}   an edgeArrayStruct
+ * 
+ * Example: f[]@lengths = lengths(edges);
+ */
+float[] lengths(const edgeArrayStruct edges){
+	vector A[], B[];
+	float result[];
+	edgepositions(edges,A,B);
+	resize(result, len(A));
+	foreach(int i; vector pos; A){
+		result[i] = distance(pos,B[i]);
+	}
+	return result;
+}
+
+/**
+ * Returns the non-normalized vectors AB == posB - posA of all edges
+ *
+ * @param {edgeArrayStruct}	{edges}   an edgeArrayStruct
+ * 
+ * Example: v[]@vectors = vectorabs(edges);
+ */
+vector[] vectorabs(const edgeArrayStruct edges){
+	vector A[], B[];
+	vector result[];
+	edgepositions(edges,A,B);
+	resize(result, len(A));
+	foreach(int i; vector pos; A){
+		result[i] = B[i]-pos;
+	}
+	return result;
+}
+
+/**
+ * Returns the normalized vectors AB == posB - posA of all edges
+ *
+ * @param {edgeArrayStruct}	{edges}   an edgeArrayStruct
+ * 
+ * Example: v[]@directions = vectorabs_n(edges);
+ */
+vector[] vectorabs_n(const edgeArrayStruct edges){
+	vector A[], B[];
+	vector result[];
+	edgepositions(edges,A,B);
+	resize(result, len(A));
+	foreach(int i; vector pos; A){
+		result[i] = normalize(B[i]-pos);
+	}
+	return result;
+}
+
+/**
+ * Returns the center positions of all edges
+ *
+ * @param {edgeArrayStruct}	{edges}   an edgeArrayStruct
+ * 
+ * Example: v[]@mids = posmids(edges);
+ */
+vector[] posmids(const edgeArrayStruct edges){
+	vector A[], B[];
+	vector result[];
+	edgepositions(edges,A,B);
+	resize(result, len(A));
+	foreach(int i; vector pos; A){
+		result[i] = (pos+B[i])*.5;
+	}
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////
+//Following is a point neighbour cache for graph walks (adjacencyStruct)//
+////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////
+
+/**
+ * \verbatim
+ * An adjacencyStruct stores the neighbour points of every point of an input once, in compressed sparse row form:
+ * the neighbours of point pt are indices[offsets[pt]] to indices[offsets[pt+1]-1].
+ * Build it once (for example in a detail wrangle) and use it for all neighbour queries of a graph walk,
+ * instead of calling neighbours() again and again.
+ * It can be stored in two detail attributes and read back in a later wrangle.
+ * If the topology changes, the adjacencyStruct has to be built again.
+ *
+ * To create a variable of type custom struct:
+ * 	adjacencyStruct adjacency = adjacencyStruct(0);
+ *
+ * To use it:
+ * 	int points[] = neighbours(adjacency, 5);
+ * 	edgeStruct edges[] = neighbours_a(adjacency, edgeStruct(5,6));
+ *
+ * To store it and read it back in a later detail wrangle:
+ * 	setdetailattribs(adjacency, "adjacency"); //writes i[]@adjacency_offsets and i[]@adjacency_indices
+ * 	adjacencyStruct adjacency = adjacencyStruct(0, "adjacency");
+ * \endverbatim
+ */
+struct adjacencyStruct{
+	int input; //input the neighbours were read from
+	int offsets[]; //start of the neighbours of every point in indices, followed by len(indices)
+	int indices[]; //neighbour points of all points, one point after the other
+
+	/**
+	 * Returns the int of the input
+	 * 
+	 * Example: int input = input(adjacency);
+	 */
+	int input(){
+		return this.input;
+	}
+
+	/**
+	 * Returns the amount of neighbours of a point
+	 * 
+	 * @param {int}	{point}   a point number
+	 *
+	 * Example: int amount = neighbourcount(adjacency, 5);
+	 */
+	int neighbourcount(const int point){
+		return this.offsets[point+1]-this.offsets[point];
+	}
+}
+
+/**
+ * Returns an adjacencyStruct with the neighbours of all points at input. Calls neighbours() once per point.
+ *
+ * @param {int}	{input}   an integer that describes an input
+ */
+adjacencyStruct adjacencyStruct(const int input){
+	int amount = npoints(input);
+	int offsets[];
+	int indices[];
+	resize(offsets, amount+1);
+	for(int pt=0; pt<amount; pt++){
+		offsets[pt] = len(indices);
+		append(indices, neighbours(input,pt) );
+	}
+	offsets[amount] = len(indices);
+	return adjacencyStruct(input,offsets,indices);
+}
+
+/**
+ * Returns an adjacencyStruct that was stored with setdetailattribs() in the detail attributes "name"_offsets and "name"_indices at input.
+ * Read it once per wrangle (in detail mode), not once per point.
+ *
+ * @param {int}	{input}   an integer that describes an input
+ * @param {string}	{name}   prefix of the detail attributes
+ */
+adjacencyStruct adjacencyStruct(const int input; const string name){
+	int offsets[] = detail(input, name+"_offsets");
+	int indices[] = detail(input, name+"_indices");
+	return adjacencyStruct(input,offsets,indices);
+}
+
+/**
+ * Stores an adjacencyStruct in the detail attributes "name"_offsets and "name"_indices of the first input (0)
+ *
+ * @param {adjacencyStruct}	{adjacency}   an adjacencyStruct
+ * @param {string}	{name}   prefix of the detail attributes
+ */
+void setdetailattribs(const adjacencyStruct adjacency; const string name){
+	setdetailattrib(0, name+"_offsets", adjacency.offsets, "set");
+	setdetailattrib(0, name+"_indices", adjacency.indices, "set");
+}
+
+/**
+ * Returns the neighbour points of a point
+ *
+ * @param {adjacencyStruct}	{adjacency}   an adjacencyStruct
+ * @param {int}	{point}   a point number
+ * 
+ * Example: i[]@nbs = neighbours(adjacency, @ptnum);
+ */
+int[] neighbours(const adjacencyStruct adjacency; const int point){
+	return adjacency.indices[ adjacency.offsets[point] : adjacency.offsets[point+1] ];
+}
+
+/**
+ * Returns all edges connected to a point
+ *
+ * @param {adjacencyStruct}	{adjacency}   an adjacencyStruct
+ * @param {int}	{point}   a point number
+ * 
+ * Example: printf(getfullname( edgestructs_frompoint(adjacency, 0) ));
+ */
+edgeStruct[] edgestructs_frompoint(const adjacencyStruct adjacency; const int point){
+	edgeStruct result[];
+	int input = input(adjacency);
+	for(int i=adjacency.offsets[point]; i<adjacency.offsets[point+1]; i++){
+		push( result, edgeStruct(input,point,adjacency.indices[i]) );
+	}
+	return result;
+}
+
+/**
+ * Returns the edges connected to point A of a given edgeStruct, without the edge itself
+ *
+ * @param {adjacencyStruct}	{adjacency}   an adjacencyStruct
+ * @param {edgeStruct}	{edge}   an edgeStruct 
+ * 
+ * Example: printf(getfullname( neighbours_a(adjacency,ed1) ));
+ */
+edgeStruct[] neighbours_a(const adjacencyStruct adjacency; const edgeStruct edge){
+	edgeStruct result[];
+	int input = input(adjacency);
+	int a = pointa(edge);
+	int b = pointb(edge);
+	for(int i=adjacency.offsets[a]; i<adjacency.offsets[a+1]; i++){
+		int pt = adjacency.indices[i];
+		if(pt!=b){
+			push( result, edgeStruct(input,a,pt) );
+		}
+	}
+	return result;
+}
+
+/**
+ * Returns the edges connected to point B of a given edgeStruct, without the edge itself
+ *
+ * @param {adjacencyStruct}	{adjacency}   an adjacencyStruct
+ * @param {edgeStruct}	{edge}   an edgeStruct 
+ * 
+ * Example: printf(getfullname( neighbours_b(adjacency,ed1) ));
+ */
+edgeStruct[] neighbours_b(const adjacencyStruct adjacency; const edgeStruct edge){
+	edgeStruct result[];
+	int input = input(adjacency);
+	int a = pointa(edge);
+	int b = pointb(edge);
+	for(int i=adjacency.offsets[b]; i<adjacency.offsets[b+1]; i++){
+		int pt = adjacency.indices[i];
+		if(pt!=a){
+			push( result, edgeStruct(input,b,pt) );
+		}
+	}
+	return result;
+}
+
+/**
+ * Returns all edges connected to both points of an edge - without the source edge
+ *
+ * @param {adjacencyStruct}	{adjacency}   an adjacencyStruct
+ * @param {edgeStruct}	{edge}   an edgeStruct 
+ * 
+ * Example: printf(getfullname( edgestructs_fromedge(adjacency, ed1) ));
+ */
+edgeStruct[] edgestructs_fromedge(const adjacencyStruct adjacency; const edgeStruct edge){
+	edgeStruct result[] = neighbours_a(adjacency,edge);
+	push( result, neighbours_b(adjacency,edge) );
+	return result;
+}
+
+/////////////////////////////////////////////
+/////////////////////////////////////////////
+//Following are path searches over the edges//
+/////////////////////////////////////////////
+/////////////////////////////////////////////
+
+/**
+ * Returns 1 if the shortest path functions can use the point attribute weightattrib at input, otherwise 0.
+ * Warns if weightattrib is not "" but does not exist.
+ *
+ * @param {int}	{input}   an integer that describes an input
+ * @param {string}	{weightattrib}   name of a float point attribute or ""
+ */
+int shortestpath_useweights(const int input; const string weightattrib){
+	if(weightattrib==""){
+		return 0;
+	}
+	if(!haspointattrib(input,weightattrib)){
+		warning("shortestpath: point attribute %s does not exist at input %i, using the edge length only.", weightattrib, input);
+		return 0;
+	}
+	return 1;
+}
+
+/**
+ * Returns the shortest path from point start to point goal as an array of edgeStructs and reuses the search buffers.
+ * The buffers need one entry per point: cost filled with 1e30, previous with -1 and done a bitarray() without set bits.
+ * Only the entries of the points that the search reached are changed, and they are reset again before it returns,
+ * so a short path does not pay for the size of the geometry. See shortestpath(adjacency, start, goal, weightattrib).
+ *
+ * @param {adjacencyStruct}	{adjacency}   an adjacencyStruct of the input
+ * @param {int}	{start}   a point number
+ * @param {int}	{goal}   a point number
+ * @param {string}	{weightattrib}   name of a float point attribute
+ * @param {int}	{useweights}   result of shortestpath_useweights(input(adjacency), weightattrib)
+ * @param {float array}	{cost}   buffer for the cost of the cheapest known way to every point
+ * @param {int array}	{previous}   buffer for the point before every point on the cheapest known way
+ * @param {int array}	{done}   bitarray() buffer of the points that are finished
+ */
+edgeStruct[] shortestpath(const adjacencyStruct adjacency; const int start, goal; const string weightattrib; const int useweights; float cost[]; int previous[]; int done[]){
+	edgeStruct result[];
+	int input = input(adjacency);
+	int amount = len(cost);
+	if(start<0 || goal<0 || start>=amount || goal>=amount || start==goal){
+		return result;
+	}
+	int cached = len(adjacency.offsets)>0;
+	vector goalpos = point(input,"P",goal);
+	int touched[] = array(start); //points whose buffer entries have to be reset afterwards
+	heapStruct heap;
+	cost[start] = 0;
+	push(heap, useweights ? 0 : distance(point(input,"P",start),goalpos), start);
+
+	float key;
+	int current;
+	while( pop(heap,key,current) ){
+		if(getbit(done,current)){ //an older, more expensive entry of a point that is done already
+			continue;
+		}
+		setbit(done,current);
+		if(current==goal){
+			break;
+		}
+		vector pos = point(input,"P",current);
+		float weight = useweights ? point(input,weightattrib,current) : 1.0;
+		int nbs[];
+		if(cached){
+			nbs = neighbours(adjacency,current);
+		}
+		else{
+			nbs = neighbours(input,current);
+		}
+		foreach(int nb; nbs){
+			if(getbit(done,nb)){
+				continue;
+			}
+			vector nbpos = point(input,"P",nb);
+			float edgecost = distance(pos,nbpos);
+			if(useweights){
+				edgecost *= ( weight + point(input,weightattrib,nb) )*.5;
+			}
+			float newcost = cost[current] + edgecost;
+			if(newcost<cost[nb]){
+				if(previous[nb]<0){ //first time the point is reached
+					append(touched, nb);
+				}
+				cost[nb] = newcost;
+				previous[nb] = current;
+				push(heap, useweights ? newcost : newcost+distance(nbpos,goalpos), nb);
+			}
+		}
+	}
+	if(previous[goal]>=0){
+		//walk back from goal and collect the edges in reverse
+		int points[];
+		for(int pt=goal; pt>=0; pt=previous[pt]){
+			append(points,pt);
+		}
+		for(int i=len(points)-1; i>0; i--){
+			push(result, edgeStruct(input,points[i],points[i-1]) );
+		}
+	}
+	foreach(int pt; touched){
+		cost[pt] = 1e30;
+		previous[pt] = -1;
+		clearbit(done,pt);
+	}
+	return result;
+}
+
+/**
+ * Returns the shortest path from point start to point goal as an array of edgeStructs (from start to goal).
+ * Returns an empty array if goal can not be reached.
+ * Runs Dijkstra with a heapStruct as priority queue. Without a weight attribute the distance to goal 
+ * is used as a lower bound (A*), so fewer points are visited.
+ * The geometry is read from input(adjacency). If the adjacencyStruct has no offsets, the neighbours are read from the geometry too.
+ * Every call sets up buffers with one entry per point. For many paths on the same geometry use shortestpaths().
+ *
+ * @param {adjacencyStruct}	{adjacency}   an adjacencyStruct of the input
+ * @param {int}	{start}   a point number
+ * @param {int}	{goal}   a point number
+ * @param {string}	{weightattrib}   name of a float point attribute. The cost of an edge is its length times the average weight of its points. Use "" for the edge length only.
+ */
+edgeStruct[] shortestpath(const adjacencyStruct adjacency; const int start, goal; const string weightattrib){
+	int input = input(adjacency);
+	int amount = npoints(input);
+	float cost[];
+	int previous[];
+	resize(cost, amount);
+	resize(previous, amount);
+	for(int pt=0; pt<amount; pt++){
+		cost[pt] = 1e30;
+		previous[pt] = -1;
+	}
+	int done[] = bitarray(amount);
+	return shortestpath(adjacency, start, goal, weightattrib, shortestpath_useweights(input,weightattrib), cost, previous, done);
+}
+
+/**
+ * Returns the shortest paths from every point in starts to the point with the same index in goals, one path after the other.
+ * The edges of path i are result[offsets[i]] to result[offsets[i+1]-1]. Paths that can not be found are empty.
+ * The search buffers are set up once for all paths and only the reached points are reset after each path,
+ * so thousands of short paths do not pay for the size of the geometry every time.
+ *
+ * @param {adjacencyStruct}	{adjacency}   an adjacencyStruct of the input
+ * @param {int array}	{starts}   point numbers
+ * @param {int array}	{goals}   point numbers, one for every start
+ * @param {string}	{weightattrib}   name of a float point attribute or "" for the edge length only
+ * @param {int array}	{offsets}   a variable that is passed by reference. Start of every path in the result, followed by len(result).
+ *
+ * Example:
+ * int offsets[];
+ * adjacencyStruct adjacency = adjacencyStruct(0);
+ * edgeStruct paths[] = shortestpaths(adjacency, i[]@starts, i[]@goals, "", offsets);
+ */
+edgeStruct[] shortestpaths(const adjacencyStruct adjacency; const int starts[]; const int goals[]; const string weightattrib; int offsets[]){
+	edgeStruct result[];
+	resize(offsets, 0);
+	int input = input(adjacency);
+	int amount = npoints(input);
+	float cost[];
+	int previous[];
+	resize(cost, amount);
+	resize(previous, amount);
+	for(int pt=0; pt<amount; pt++){
+		cost[pt] = 1e30;
+		previous[pt] = -1;
+	}
+	int done[] = bitarray(amount);
+	int useweights = shortestpath_useweights(input,weightattrib);
+	int paths = min(len(starts), len(goals));
+	for(int i=0; i<paths; i++){
+		append(offsets, len(result));
+		push(result, shortestpath(adjacency, starts[i], goals[i], weightattrib, useweights, cost, previous, done) );
+	}
+	append(offsets, len(result));
+	return result;
+}
+
+/**
+ * Returns the shortest path from point start to point goal at input as an array of edgeStructs (from start to goal).
+ * See shortestpath(adjacency, start, goal, weightattrib). 
+ * If you search many paths on the same geometry, build an adjacencyStruct once and use that version.
+ *
+ * @param {int}	{input}   an integer that describes an input
+ * @param {int}	{start}   a point number
+ * @param {int}	{goal}   a point number
+ * @param {string}	{weightattrib}   name of a float point attribute or "" for the edge length only
+ *
+ * Example: printf(getfullname( shortestpath(0, 0, 42, "") ));
+ */
+edgeStruct[] shortestpath(const int input; const int start, goal; const string weightattrib){
+	adjacencyStruct adjacency; //no offsets, so the neighbours are read from the geometry
+	adjacency.input = input;
+	return shortestpath(adjacency, start, goal, weightattrib);
+}
+
 #endif
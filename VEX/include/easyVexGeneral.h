@@ -1,6 +1,9 @@
 #ifndef __easyVexGeneral_h__
 #define __easyVexGeneral_h__
 
+//Required if included on its own:
+#include "easyVexGrids.h"
+
 /**
  * Functions that simplify general tasks. 
  */
@@ -69,7 +72,7 @@ function float round( const vector value; const int decimal)
  */
 function vector nearpointp( const vector pos)
 {
-	return point(0, “P”, nearpoint(0, pos) );
+	return point(0, "P", nearpoint(0, pos) );
 }
 
 /**
@@ -82,7 +85,82 @@ function vector nearpointp( const vector pos)
  */
 function vector nearpointp( const int input; const vector pos)
 {
-	return point(input, “P”, nearpoint(input, pos) );
+	return point(input, "P", nearpoint(input, pos) );
+}
+
+/**
+ * Returns the nearest point ids for an array of query positions at input. 
+ * The positions of the found points are written into the parallel array positions.
+ * If no point is within maxdist, the id is -1 and the position is {0,0,0}.
+ * 
+ * @param {int}	{input}   number of the input that we look at to find the geometry
+ * @param {vector array}	{queries}	positions that we examine
+ * @param {float}	{maxdist}	maximum search distance
+ * @param {vector array}	{positions}	a variable that is passed by reference. It will contain the position of every found point.
+ *
+ * Example:
+ * vector positions[];
+ * i[]@nearest = nearpointsp(1, v[]@queries, 0.5, positions);
+ */
+function int[] nearpointsp( const int input; const vector queries[]; const float maxdist; vector positions[])
+{
+	int result[];
+	int amount = len(queries);
+	resize(result, amount);
+	resize(positions, amount);
+	foreach(int i; vector pos; queries){
+		int pt = nearpoint(input, pos, maxdist);
+		result[i] = pt;
+		positions[i] = pt<0 ? set(0,0,0) : point(input, "P", pt);
+	}
+	return result;
+}
+
+/**
+ * Returns the maxpts nearest point ids for every query position at input, closest first.
+ * Every query gets maxpts slots: the points of query i are at i*maxpts to i*maxpts+maxpts-1. Unused slots are -1.
+ * Returns an empty array if maxpts is smaller than 1.
+ * The positions of the found points are written into the parallel array positions.
+ * Ids and positions come from the same point cloud lookup, so there is no extra point() call per point.
+ * 
+ * @param {int}	{input}   number of the input that we look at to find the geometry
+ * @param {vector array}	{queries}	positions that we examine
+ * @param {float}	{maxdist}	maximum search distance
+ * @param {int}	{maxpts}	amount of points per query
+ * @param {vector array}	{positions}	a variable that is passed by reference. It will contain the position of every found point.
+ *
+ * Example:
+ * vector positions[];
+ * i[]@nearest = nearpointsp(1, v[]@queries, 0.5, 3, positions); //three points per query
+ */
+function int[] nearpointsp( const int input; const vector queries[]; const float maxdist; const int maxpts; vector positions[])
+{
+	int result[];
+	resize(positions, 0);
+	if(maxpts<1){
+		return result;
+	}
+	int amount = len(queries)*maxpts;
+	resize(result, amount);
+	resize(positions, amount);
+	for(int slot=0; slot<amount; slot++){
+		result[slot] = -1;
+	}
+	foreach(int i; vector query; queries){
+		int slot = i*maxpts;
+		int pt;
+		vector pos;
+		int handle = pcopen(input, "P", query, maxdist, maxpts);
+		while(pciterate(handle)){
+			pcimport(handle, "point.number", pt);
+			pcimport(handle, "P", pos);
+			result[slot] = pt;
+			positions[slot] = pos;
+			slot++;
+		}
+		pcclose(handle);
+	}
+	return result;
 }
 
 /**
@@ -194,19 +272,26 @@ function float[] uniquearray(const float numbers[]; const float tolerance) {
 }
 
 /**
- * Returns vector array of unique values (no duplicates) sorted in ascending order.
+ * Returns vector array of unique values (no duplicates) in the order of their first appearance.
+ * A vector is removed if an earlier vector that was kept is within tolerance of it.
+ * The vectors are sorted into a hashGridStruct with tolerance sized cells, so every vector is only
+ * compared to the vectors in the neighbouring cells. This takes O(n log n) instead of O(n*n).
  * 
- * @param {float array}	{numbers}   arbitrary vector array
+ * @param {vector array}	{numbers}   arbitrary vector array
  * @param {float}	{tolerance}   Tolerance value (+-) for comparison 
+ * @param {int array}	{remap}   a variable that is passed by reference. For every index in numbers it contains the index of the matching vector in the result.
  *
  * Example:
  * vector testVectorArray[] = {{1.001, 1.0, 1.0},{1.0, 1.0, 1.0},{2.0, 1.0, 1.0}};
- * v[]@array = uniquearray(testVectorArray,0.1); //Result: {1.001, 1.0, 1.0},{2.0, 1.0, 1.0}
- * v[]@array2 = testVectorArray; //The original stays the same!
+ * int remap[];
+ * v[]@array = uniquearray(testVectorArray,0.1,remap); //Result: {1.001, 1.0, 1.0},{2.0, 1.0, 1.0}
+ * i[]@remap = remap; //Result: {0,0,1}
  */
-function vector[] uniquearray(const vector numbers[]; const float tolerance) {
+function vector[] uniquearray(const vector numbers[]; const float tolerance; int remap[]) {
 	vector clean[] = {};
-	int inside = 0;
+	int kept[];
+	resize(remap, len(numbers));
+	resize(kept, len(numbers));
 
 	//fail safe
 	if (len(numbers) == 0) {
@@ -214,21 +299,49 @@ function vector[] uniquearray(const vector numbers[]; const float tolerance) {
 		return clean;
 	}
 
-	foreach (vector vec; numbers) {
-		foreach (vector vec2; clean)
-		{
-		    inside+=isequal(vec,vec2,tolerance); //increase if the number is already there
+	hashGridStruct grid = hashGridStruct(numbers, tolerance);
+	foreach (int i; vector vec; numbers) {
+		int match = -1;
+		foreach (int candidate; radiuspoints(grid, vec, tolerance)) {
+			//only vectors that came earlier and were kept count, the earliest one wins
+			if (candidate<i && kept[candidate] && (match<0 || candidate<match)) {
+				match = candidate;
+			}
 		}
-		if (inside<1) { //if the number is not already there, add it
+		if (match<0) { //if the number is not already there, add it
+			kept[i] = 1;
+			remap[i] = len(clean);
 			append(clean, vec);
 		}
-		inside = 0;
+		else {
+			remap[i] = remap[match];
+		}
 	}
 	return clean;
 }
 
+/**
+ * Returns vector array of unique values (no duplicates) in the order of their first appearance.
+ * See uniquearray(numbers, tolerance, remap) for details.
+ * 
+ * @param {vector array}	{numbers}   arbitrary vector array
+ * @param {float}	{tolerance}   Tolerance value (+-) for comparison 
+ *
+ * Example:
+ * vector testVectorArray[] = {{1.001, 1.0, 1.0},{1.0, 1.0, 1.0},{2.0, 1.0, 1.0}};
+ * v[]@array = uniquearray(testVectorArray,0.1); //Result: {1.001, 1.0, 1.0},{2.0, 1.0, 1.0}
+ * v[]@array2 = testVectorArray; //The original stays the same!
+ */
+function vector[] uniquearray(const vector numbers[]; const float tolerance) {
+	int remap[];
+	return uniquearray(numbers, tolerance, remap);
+}
+
 /**
  * Adds only new int values (no duplicates) to an int array and returns the modified array. The original gets modified.
+ * Every call searches the whole array, so collecting n values one by one takes O(n^2). 
+ * If you collect many values, append them all and remove the duplicates once with uniquearray(), 
+ * or insert them in batches into an intSetStruct with insert(set, values[]).
  * 
  * @param {int array}	{numbers}   arbitrary integer array
  * @param {int}	{num}   number to add
@@ -285,31 +398,509 @@ function vector[] appendunique(vector numbers[]; const vector num) {
 }
 
 /**
- * Removes all instances of int value from int array
+ * \verbatim
+ * An intSetStruct is a collection of unique ints, kept sorted in ascending order.
+ * contains() is a binary search (O(log n)) instead of the linear find() that appendunique() does.
+ * Adding values one at a time with insert(set, value) still shifts the sorted array (O(n) per value), 
+ * so building a big set value by value is O(n^2) like appendunique(). Collect the values in an array and 
+ * add them with insert(set, values[]) (one sort, O(n log n)) instead.
+ *
+ * To create a set:
+ * 	intSetStruct set1; //empty
+ * 	intSetStruct set2 = intsetstruct_fromarray(points); //from arbitrary ints
+ *
+ * To use it:
+ * 	insert(set1, 5); //returns 1, because 5 was new
+ * 	insert(set1, 5); //returns 0, because 5 was already there
+ * 	int inside = contains(set1, 5); //1
+ * 	remove(set1, 5);
+ * 	i[]@values = getints(set1);
+ * \endverbatim
+ */
+struct intSetStruct{
+	int values[]; //unique values in ascending order
+
+	/**
+	 * Returns 1 if value is in the set, otherwise 0
+	 *
+	 * @param {int}	{value}   value to look for
+	 *
+	 * Example: int inside = contains(set1, 5);
+	 */
+	int contains(const int value){
+		return findsorted(this.values, value)>=0;
+	}
+
+	/**
+	 * Adds value to the set. Returns 1 if the value was new, 0 if it was already in the set.
+	 * Moves all bigger values one slot back, so this takes O(n). Use insert(set, values[]) for many values.
+	 *
+	 * @param {int}	{value}   value to add
+	 *
+	 * Example: insert(set1, 5);
+	 */
+	int insert(const int value){
+		int index = lowerbound(this.values, value);
+		if(index<len(this.values) && this.values[index]==value){
+			return 0;
+		}
+		insert(this.values, index, value);
+		return 1;
+	}
+
+	/**
+	 * Adds all values of an int array to the set with one sort (O((n+m) log(n+m))). 
+	 * Much faster than inserting the values one by one, if you add many values at once.
+	 *
+	 * @param {int array}	{values}   arbitrary int array
+	 *
+	 * Example: insert(set1, neighbours(0, @ptnum));
+	 */
+	void insert(const int values[]){
+		if(len(values)==0){
+			return;
+		}
+		int all[] = this.values;
+		append(all, values);
+		this.values = uniquearray(all);
+	}
+
+	/**
+	 * Removes value from the set. Returns 1 if the value was in the set, otherwise 0.
+	 *
+	 * @param {int}	{value}   value to remove
+	 *
+	 * Example: remove(set1, 5);
+	 */
+	int remove(const int value){
+		int index = findsorted(this.values, value);
+		if(index<0){
+			return 0;
+		}
+		removeindex(this.values, index);
+		return 1;
+	}
+
+	/**
+	 * Returns all values of the set as int array in ascending order
+	 *
+	 * Example: i[]@values = getints(set1);
+	 */
+	int[] getints(){
+		return this.values;
+	}
+}
+
+/**
+ * Returns an intSetStruct that contains every value of an int array once
+ *
+ * @param {int array}	{numbers}   arbitrary integer array
+ *
+ * Example: intSetStruct set1 = intsetstruct_fromarray( array(3,1,3) ); //contains 1 and 3
+ */
+intSetStruct intsetstruct_fromarray(const int numbers[]){
+	intSetStruct result;
+	insert(result, numbers);
+	return result;
+}
+
+/**
+ * Removes all instances of int value from int array.
+ * The remaining values are moved to the front in one pass, so this takes O(n).
  * 
  * @param {int array}	{numbers}   arbitrary integer array
  * @param {int}	{remove}   integer value to be removed from the array
  */
 function void removevalues(int numbers[]; const int remove) {
-	while (1) {
-		int temp;
-		temp = removevalue(numbers, remove);
-		if (temp == 0) {
-			break;
+	int amount = len(numbers);
+	int write = 0; //next free slot for a value we keep
+	for (int i = 0; i<amount; i++) {
+		if (numbers[i] != remove) {
+			numbers[write] = numbers[i];
+			write++;
 		}
 	}
+	resize(numbers, write);
 }
 
 /**
- * Removes all instances of all int values in seccond array from first int array
+ * Returns an int array with one entry per value in values: 1 if the value is also in others, otherwise 0.
+ * Both arrays are sorted and walked once side by side, so this takes O(n log n + m log m).
+ * 
+ * @param {int array}	{values}   arbitrary integer array
+ * @param {int array}	{others}   arbitrary integer array to look for the values in
+ *
+ * Example:
+ * int testIntArray[] = {4,1,7};
+ * i[]@found = containsvalues(testIntArray, array(7,4)); //{1,0,1}
+ */
+function int[] containsvalues(const int values[]; const int others[]) {
+	int result[];
+	resize(result, len(values));
+	int order[] = argsort(values);
+	int sortedothers[] = sort(others);
+	int otheramount = len(sortedothers);
+	int r = 0;
+	foreach (int index; order) {
+		int num = values[index];
+		while (r<otheramount && sortedothers[r]<num) {
+			r++;
+		}
+		if (r<otheramount && sortedothers[r]==num) {
+			result[index] = 1;
+		}
+	}
+	return result;
+}
+
+/**
+ * Returns an int array with one entry per value in values: 1 if it is the first occurrence of the value, otherwise 0.
+ * 
+ * @param {int array}	{values}   arbitrary integer array
+ *
+ * Example:
+ * int testIntArray[] = {4,1,4};
+ * i[]@first = firstvalues(testIntArray); //{1,1,0}
+ */
+function int[] firstvalues(const int values[]) {
+	int result[];
+	resize(result, len(values));
+	int order[] = argsort(values); //stable, so the first occurrence comes first
+	foreach (int i; int index; order) {
+		if (i==0 || values[index]!=values[order[i-1]]) {
+			result[index] = 1;
+		}
+	}
+	return result;
+}
+
+/**
+ * Returns for every value its index in the sorted unique values (dense labels from 0 to len(unique)-1).
+ * Use it to turn sparse numbers (for example the point numbers of a few edges on a big mesh) into a small range
+ * for lookup tables, without allocating arrays for the biggest value. Takes O(n log n).
+ * 
+ * @param {int array}	{values}   arbitrary integer array
+ * @param {int array}	{unique}   a variable that is passed by reference. It will contain the unique values in ascending order, so unique[label] is the original value.
+ *
+ * Example:
+ * int unique[];
+ * i[]@labels = denselabels({50000,7,50000}, unique); //{1,0,1}, unique is {7,50000}
+ */
+function int[] denselabels(const int values[]; int unique[]) {
+	int result[];
+	resize(result, len(values));
+	resize(unique, 0);
+	int order[] = argsort(values);
+	foreach (int i; int index; order) {
+		if (i==0 || values[index]!=values[order[i-1]]) {
+			append(unique, values[index]);
+		}
+		result[index] = len(unique)-1;
+	}
+	return result;
+}
+
+/**
+ * Removes all instances of all int values in seccond array from first int array.
+ * The order of the remaining values stays the same.
+ * If the values are dense (for example point numbers) a lookup table is used, which takes O(n+m).
+ * Otherwise both arrays are sorted and merged, which takes O(n log n + m log m).
  * 
  * @param {int array}	{numbers}   arbitrary integer array
  * @param {int array}	{remove}   arbitrary integer array to be removed from the numbers array
  */
 function void removevalues(int numbers[]; const int remove[]) {
-	foreach(int num; remove){
-		removevalues(numbers, num);
+	int amount = len(numbers);
+	int removeamount = len(remove);
+	if (amount == 0 || removeamount == 0) {
+		return;
+	}
+	int drop[]; //1 for every index in numbers that should be removed
+	resize(drop, amount);
+
+	int lowest = min(numbers);
+	int range = max(numbers) - lowest + 1;
+	if (range>0 && range<=4*(amount+removeamount)) {
+		//dense values: mark the values to remove in a lookup table
+		int table[];
+		resize(table, range);
+		foreach (int num; remove) {
+			if (num>=lowest && num-lowest<range) {
+				table[num-lowest] = 1;
+			}
+		}
+		for (int i = 0; i<amount; i++) {
+			drop[i] = table[numbers[i]-lowest];
+		}
+	}
+	else {
+		//sparse values: walk both arrays in sorted order
+		drop = containsvalues(numbers, remove);
+	}
+
+	int write = 0; //next free slot for a value we keep
+	for (int i = 0; i<amount; i++) {
+		if (!drop[i]) {
+			numbers[write] = numbers[i];
+			write++;
+		}
+	}
+	resize(numbers, write);
+}
+
+/**
+ * Returns an int array that can hold amount flags (bits), all set to 0. Every int holds 32 flags.
+ * Use it with getbit() and setbit() instead of find() on a growing array to remember visited elements.
+ * 
+ * @param {int}	{amount}   amount of flags
+ *
+ * Example:
+ * int visited[] = bitarray(npoints(0));
+ * setbit(visited, 5);
+ * i@seen = getbit(visited, 5); //1
+ */
+function int[] bitarray(const int amount){
+	int result[];
+	resize(result, (max(amount,0)+31)/32);
+	return result;
+}
+
+/**
+ * Returns flag number index of a bit array (1 or 0)
+ * 
+ * @param {int array}	{bits}   a bit array, see bitarray()
+ * @param {int}	{index}   number of the flag
+ */
+function int getbit(const int bits[]; const int index){
+	return (bits[index/32] >> (index%32)) & 1;
+}
+
+/**
+ * Sets flag number index of a bit array to 1
+ * 
+ * @param {int array}	{bits}   a bit array, see bitarray()
+ * @param {int}	{index}   number of the flag
+ */
+function void setbit(int bits[]; const int index){
+	bits[index/32] = bits[index/32] | (1 << (index%32));
+}
+
+/**
+ * Sets flag number index of a bit array to 0
+ * 
+ * @param {int array}	{bits}   a bit array, see bitarray()
+ * @param {int}	{index}   number of the flag
+ */
+function void clearbit(int bits[]; const int index){
+	bits[index/32] = bits[index/32] & ~(1 << (index%32));
+}
+
+/**
+ * \verbatim
+ * A heapStruct is a priority queue (binary min-heap) of int values with float keys.
+ * pop() always returns the value with the smallest key. push() and pop() take O(log n).
+ *
+ * To create a variable of type custom struct:
+ * 	heapStruct heap; //empty
+ *
+ * To use it:
+ * 	push(heap, 2.5, 7); //key 2.5, value 7
+ * 	push(heap, 1.0, 3);
+ * 	float key;
+ * 	int value;
+ * 	while( pop(heap, key, value) ){
+ * 		printf("%i with key %g\n", value, key); //3 first, then 7
+ * 	}
+ * \endverbatim
+ */
+struct heapStruct{
+	float keys[]; //keys in heap order: keys[i] is never bigger than keys[2*i+1] and keys[2*i+2]
+	int values[]; //value for every key
+
+	/**
+	 * Returns the amount of entries in the heap
+	 *
+	 * Example: int amount = size(heap);
+	 */
+	int size(){
+		return len(this.keys);
+	}
+}
+
+/**
+ * Adds a value with a key to a heapStruct
+ *
+ * @param {heapStruct}	{heap}   a heapStruct
+ * @param {float}	{key}   priority of the value. Smaller keys come first.
+ * @param {int}	{value}   arbitrary int
+ */
+void push(heapStruct heap; const float key; const int value){
+	int i = len(heap.keys);
+	append(heap.keys, key);
+	append(heap.values, value);
+	//move the new entry up until its parent is smaller
+	while(i>0){
+		int parent = (i-1)/2;
+		if(heap.keys[parent]<=key){
+			break;
+		}
+		heap.keys[i] = heap.keys[parent];
+		heap.values[i] = heap.values[parent];
+		i = parent;
 	}
+	heap.keys[i] = key;
+	heap.values[i] = value;
+}
+
+/**
+ * Removes the entry with the smallest key from a heapStruct and writes it into key and value.
+ * Returns 1 if there was an entry, 0 if the heap was empty.
+ *
+ * @param {heapStruct}	{heap}   a heapStruct
+ * @param {float}	{key}   a variable that is passed by reference. It will contain the smallest key.
+ * @param {int}	{value}   a variable that is passed by reference. It will contain the value of the smallest key.
+ */
+int pop(heapStruct heap; float key; int value){
+	int amount = len(heap.keys);
+	if(amount==0){
+		return 0;
+	}
+	key = heap.keys[0];
+	value = heap.values[0];
+	//move the last entry to the top and then down until both children are bigger
+	float lastkey = heap.keys[amount-1];
+	int lastvalue = heap.values[amount-1];
+	amount--;
+	resize(heap.keys, amount);
+	resize(heap.values, amount);
+	if(amount==0){
+		return 1;
+	}
+	int i = 0;
+	while(1){
+		int child = 2*i+1;
+		if(child>=amount){
+			break;
+		}
+		if(child+1<amount && heap.keys[child+1]<heap.keys[child]){
+			child++;
+		}
+		if(heap.keys[child]>=lastkey){
+			break;
+		}
+		heap.keys[i] = heap.keys[child];
+		heap.values[i] = heap.values[child];
+		i = child;
+	}
+	heap.keys[i] = lastkey;
+	heap.values[i] = lastvalue;
+	return 1;
+}
+
+/**
+ * \verbatim
+ * A disjointSetStruct (union-find) keeps track of which of the elements 0 to n-1 belong together.
+ * Joining two groups and finding the group of an element take almost constant time 
+ * (path compression and union by rank).
+ *
+ * To create a variable of type custom struct:
+ * 	disjointSetStruct sets = disjointSetStruct(10); //elements 0 to 9, each in its own group
+ *
+ * To use it:
+ * 	unite(sets, 1, 2);
+ * 	unite(sets, 2, 3);
+ * 	int together = findroot(sets, 1)==findroot(sets, 3); //1
+ * 	i[]@groups = components(sets); //group id for every element
+ * \endverbatim
+ */
+struct disjointSetStruct{
+	int parent[]; //parent element of every element. An element that is its own parent is the root of its group.
+	int rank[]; //upper bound for the depth of the tree below every root
+}
+
+/**
+ * Returns a disjointSetStruct with the elements 0 to amount-1, each in its own group
+ *
+ * @param {int}	{amount}   amount of elements
+ */
+disjointSetStruct disjointSetStruct(const int amount){
+	int parent[], rank[];
+	resize(parent, amount);
+	resize(rank, amount);
+	for(int i=0; i<amount; i++){
+		parent[i] = i;
+	}
+	return disjointSetStruct(parent, rank);
+}
+
+/**
+ * Returns the root element of the group of element. 
+ * All elements on the way to the root are linked to the root directly (path compression), so the disjointSetStruct is modified.
+ *
+ * @param {disjointSetStruct}	{sets}   a disjointSetStruct
+ * @param {int}	{element}   an element
+ */
+int findroot(disjointSetStruct sets; const int element){
+	int root = element;
+	while(sets.parent[root]!=root){
+		root = sets.parent[root];
+	}
+	int current = element;
+	while(sets.parent[current]!=root && current!=root){
+		int next = sets.parent[current];
+		sets.parent[current] = root;
+		current = next;
+	}
+	return root;
+}
+
+/**
+ * Joins the groups of element1 and element2. Returns 1 if they were in different groups, 0 if they already were in the same group.
+ *
+ * @param {disjointSetStruct}	{sets}   a disjointSetStruct
+ * @param {int}	{element1}   an element
+ * @param {int}	{element2}   an element
+ */
+int unite(disjointSetStruct sets; const int element1, element2){
+	int root1 = findroot(sets, element1);
+	int root2 = findroot(sets, element2);
+	if(root1==root2){
+		return 0;
+	}
+	//attach the lower tree to the higher one
+	if(sets.rank[root1]<sets.rank[root2]){
+		sets.parent[root1] = root2;
+	}
+	else if(sets.rank[root1]>sets.rank[root2]){
+		sets.parent[root2] = root1;
+	}
+	else{
+		sets.parent[root2] = root1;
+		sets.rank[root1] += 1;
+	}
+	return 1;
+}
+
+/**
+ * Returns a group id for every element. The ids go from 0 to the amount of groups-1, in the order the groups first appear.
+ *
+ * @param {disjointSetStruct}	{sets}   a disjointSetStruct
+ */
+int[] components(disjointSetStruct sets){
+	int amount = len(sets.parent);
+	int result[], ids[];
+	resize(result, amount);
+	resize(ids, amount);
+	int count = 0;
+	for(int i=0; i<amount; i++){
+		int root = findroot(sets, i);
+		if(ids[root]==0){ //ids are stored +1, so 0 means not assigned yet
+			count++;
+			ids[root] = count;
+		}
+		result[i] = ids[root]-1;
+	}
+	return result;
 }
 
 /**
@@ -342,6 +933,37 @@ function vector pointp(const int point){
 	return point(0,"P",point);
 }
 
+/**
+ * Returns the positions of an array of points at input
+ * 
+ * @param {int}	{input}	 number of the input that we look at to find the geometry
+ * @param {int array}	{points}  point indices
+ */
+function vector[] pointsp(const int input; const int points[]){
+	vector result[];
+	resize(result, len(points));
+	foreach(int i; int pt; points){
+		result[i] = point(input,"P",pt);
+	}
+	return result;
+}
+
+/**
+ * Returns the positions of all points at input. The index in the array is the point number.
+ * Reading all positions once is cheaper than calling point() for the same points again and again.
+ * 
+ * @param {int}	{input}	 number of the input that we look at to find the geometry
+ */
+function vector[] pointsp(const int input){
+	vector result[];
+	int amount = npoints(input);
+	resize(result, amount);
+	for(int pt=0; pt<amount; pt++){
+		result[pt] = point(input,"P",pt);
+	}
+	return result;
+}
+
 /**
  * Returns the angle between two vectors in degrees
  * 
@@ -366,6 +988,38 @@ function float angle_d(const vector2 u,v){
 	return degrees( acos( dot(u,v)/( length(v)*length(u) )  ) );
 }
 
+/**
+ * Returns the signed angle from u to v in radians around a rotation axis, in the range -PI to PI.
+ * The angle is positive for a right handed (counterclockwise) rotation around axis.
+ * The vectors are measured in the plane perpendicular to axis, they do not need to be normalized.
+ * 
+ * @param {vector}	{u}  arbitrary vector
+ * @param {vector}	{v}  arbitrary vector
+ * @param {vector}	{axis}	rotation axis around which we measure the angle
+ *
+ * Example: f@angle = angle_signed({1,0,0},{0,0,-1},{0,1,0}); //f@angle == PI/2
+ */
+float angle_signed(const vector u,v; const vector axis){
+    vector n = normalize(axis);
+    float du = dot(u,n);
+    float dv = dot(v,n);
+    //dot and cross of u and v projected onto the plane perpendicular to n
+    return atan2( dot(n, cross(u,v)), dot(u,v)-du*dv );
+}
+
+/**
+ * Returns angle between two vectors in radians around a rotation axis.
+ * Equal directions return PI (or -PI), opposite directions return 0, it is angle_signed() shifted by PI.
+ * 
+ * @param {vector}	{u}  arbitrary vector
+ * @param {vector}	{v}  arbitrary vector
+ * @param {vector}	{axis}	rotation axis around which we measure the angle
+ */
+float angle_around(const vector u,v; const vector axis){
+    float angle = angle_signed(u,v,axis);
+    return angle>0 ? angle-PI : angle+PI;
+}
+
 /**
  * Returns dot product of two vectors, but normalizes the vectors beforehand
  * 
@@ -456,8 +1110,182 @@ void distances_n(const string name; const vector target){
 	}
 }
 
-///////////TO DO: distances_n for an array of input locations, potentially with varying interpolation methods
+/**
+ * Returns a distance that no point at input is further away from target than.
+ * That is the distance from target to the furthest corner of the bounding box of input.
+ * 
+ * @param {int}	{input}  number of the input that we look at to find the geometry
+ * @param {vector}	{target}  target position
+ */
+float distancebound(const int input; const vector target){
+	vector bmin = getbbox_min(input);
+	vector bmax = getbbox_max(input);
+	vector furthest = max( abs(bmin-target), abs(bmax-target) );
+	return length(furthest);
+}
+
+/**
+ * Stores the distance of one point for the point-parallel versions of distances_n and merges it into the detail attributes
+ * "name"_max, "name"_bound and "name"_minoffset that distances_n_normalize() reads.
+ * The "max" merges start from the values these detail attributes already have, so they must not exist on the incoming geometry.
+ * distances_n_normalize() removes them again.
+ * 
+ * @param {string}	{name}  point attribute to write to
+ * @param {int}	{ptnum}  point number
+ * @param {float}	{distanceToTarget}  the distance of the point
+ * @param {float}	{bound}  a distance that no point exceeds. Has to be the same for every point.
+ */
+void distances_n_store(const string name; const int ptnum; const float distanceToTarget; const float bound){
+	setpointattrib(0,name,ptnum,distanceToTarget,"set");
+	setdetailattrib(0,name+"_max",distanceToTarget,"max");
+	setdetailattrib(0,name+"_bound",bound,"set"); //the same value for every point
+	setdetailattrib(0,name+"_minoffset",bound-distanceToTarget,"max");
+}
+
+/**
+ * First pass of the point-parallel version of distances_n. Run it in a point wrangle, then run distances_n_normalize() in a seccond point wrangle.
+ * Calculates the distance to target position for the point and stores it in the point attribute "name".
+ * Collects the minimum and maximum distance in the detail attributes "name"_max, "name"_bound and "name"_minoffset 
+ * ("min" merges start at 0, so the minimum is stored as bound - distance with a "max" merge).
+ * These detail attributes must not exist on the incoming geometry, otherwise their old values are merged in. 
+ * distances_n_normalize() removes them, so running both passes several times in a row is fine.
+ * Unlike distances_n() this runs on all cores.
+ * 
+ * @param {string}	{name}  point attribute to write to
+ * @param {vector}	{target}  target position that we calculate distance to
+ * @param {int}	{ptnum}  point number, usually @ptnum
+ *
+ * Example:
+ * //Point wrangle 1:
+ * distances_n_point("dist", {0,0,0}, @ptnum);
+ * //Point wrangle 2:
+ * distances_n_normalize("dist", @ptnum);
+ */
+void distances_n_point(const string name; const vector target; const int ptnum){
+	float distanceToTarget = distance( point(0,"P",ptnum), target );
+	distances_n_store(name, ptnum, distanceToTarget, distancebound(0, target) );
+}
+
+/**
+ * Seccond pass of the point-parallel version of distances_n. Run it in a point wrangle after distances_n_point().
+ * Normalizes the point attribute "name" with the minimum and maximum collected by the first pass.
+ * Removes the detail attributes "name"_max, "name"_bound and "name"_minoffset of the first pass afterwards.
+ * 
+ * @param {string}	{name}  point attribute that distances_n_point() wrote to
+ * @param {int}	{ptnum}  point number, usually @ptnum
+ */
+void distances_n_normalize(const string name; const int ptnum){
+	float maxDistance = detail(0,name+"_max");
+	float minDistance = detail(0,name+"_bound") - detail(0,name+"_minoffset");
+	maxDistance -= minDistance;
+	float distanceToTarget = point(0,name,ptnum);
+	float normalizedDistanceToTarget = maxDistance>0 ? (distanceToTarget-minDistance)/maxDistance : 0;
+	setpointattrib(0,name,ptnum,normalizedDistanceToTarget,"set");
+	//the removal is applied after all points ran, so every point still reads the values above
+	removedetailattrib(0,name+"_max");
+	removedetailattrib(0,name+"_bound");
+	removedetailattrib(0,name+"_minoffset");
+}
+
+/**
+ * Returns the inverse distance weighted blend of distances. Closer distances have more influence.
+ * 
+ * @param {float array}	{distances}  arbitrary float array of distances
+ */
+float blenddistances(const float distances[]){
+	float weighted = 0;
+	float weights = 0;
+	foreach(float dist; distances){
+		float weight = 1.0/max(dist*dist, 1e-12);
+		weighted += weight*dist;
+		weights += weight;
+	}
+	return weights>0 ? weighted/weights : 0;
+}
 
+/**
+ * Calculates the distance to an array of target positions for every point and normalizes it across the geometry. 
+ * Sets a point attribute "name" to have this value.
+ * Processes all points at first input when executed once. 
+ * The targets are sorted into a hashGridStruct once, so every point only looks at the targets around it.
+ * 
+ * mode:
+ * (0) distance to the nearest target
+ * (1) inverse distance weighted blend of the distances to the 4 nearest targets
+ *
+ * @param {string}	{name}  point attribute to write to
+ * @param {vector array}	{targets}  target positions that we calculate distances to
+ * @param {int}	{mode}  how the distances to the targets are combined (see above)
+ *
+ * Example: distances_n("dist", v[]@targets, 0);
+ */
+void distances_n(const string name; const vector targets[]; const int mode){
+	if(len(targets)==0){
+		warning("Passed empty target array into distances_n function");
+		return;
+	}
+	float maxDistance,minDistance;
+	float distancesToTarget[];
+	int amount = npoints(0);
+	resize(distancesToTarget, amount);
+	hashGridStruct grid = hashGridStruct(targets, 0);
+	//Store distances
+	for(int perPoint=0;perPoint<amount;perPoint++){
+		vector pos = point(0,"P",perPoint);
+		if(mode==1){
+			float dists[];
+			foreach(int target; nearpoints(grid,pos,1e30,4)){
+				append(dists, distance(pos,targets[target]) );
+			}
+			distancesToTarget[perPoint] = blenddistances(dists);
+		}
+		else{
+			distancesToTarget[perPoint] = distance(pos,targets[nearpoint(grid,pos)]);
+		}
+	}
+	//Calculate min and max distances
+	minDistance = min(distancesToTarget);
+	maxDistance = max(distancesToTarget);
+	maxDistance -= minDistance;
+	//Set normalized attribute
+	for(int i=0;i<amount;i++ ){
+	    float normalizedDistanceToTarget = maxDistance>0 ? (distancesToTarget[i]-minDistance)/maxDistance : 0;
+	    setpointattrib(0,name,i,normalizedDistanceToTarget,"set");
+	}
+}
 
+/**
+ * First pass of the point-parallel version of distances_n for many targets. Run it in a point wrangle, then run distances_n_normalize() in a seccond point wrangle.
+ * The targets are the points at targetinput. They are searched with pcfind(), so Houdini builds its point tree once and shares it between all points.
+ * Like distances_n_point(name, target, ptnum) it needs the detail attributes "name"_max, "name"_bound and "name"_minoffset to not exist upstream.
+ * 
+ * mode:
+ * (0) distance to the nearest target
+ * (1) inverse distance weighted blend of the distances to the 4 nearest targets
+ *
+ * @param {string}	{name}  point attribute to write to
+ * @param {int}	{targetinput}  number of the input that holds the target points
+ * @param {int}	{mode}  how the distances to the targets are combined (see above)
+ * @param {int}	{ptnum}  point number, usually @ptnum
+ *
+ * Example:
+ * //Point wrangle 1 with the targets at the seccond input:
+ * distances_n_point("dist", 1, 0, @ptnum);
+ * //Point wrangle 2:
+ * distances_n_normalize("dist", @ptnum);
+ */
+void distances_n_point(const string name; const int targetinput; const int mode; const int ptnum){
+	vector pos = point(0,"P",ptnum);
+	float dists[];
+	pcfind(targetinput, "P", pos, 1e30, mode==1 ? 4 : 1, dists);
+	if(len(dists)==0){
+		warning("distances_n_point: No target points at input %i", targetinput);
+		return;
+	}
+	float distanceToTarget = mode==1 ? blenddistances(dists) : dists[0];
+	//no point is further away from any target than from the center of the targets plus their radius
+	float bound = distancebound(0, getbbox_center(targetinput)) + length(getbbox_size(targetinput))*.5;
+	distances_n_store(name, ptnum, distanceToTarget, bound);
+}
 
 #endif
@@ -1,5 +1,9 @@
 #ifndef __easyVexGeo_h__
 #define __easyVexGeo_h__
+
+//Required if included on its own:
+#include "easyVexGeneral.h"
+
 /**
  * Functions that create or modify geometry. 
  */
@@ -100,5 +104,176 @@ int[] circle(const vector origin; const int divisions; const vector up; const ve
 	return circle(origin, divisions, up, axis, radius, uv_v_offset, 0);
 }
 
+/**
+ * Finds points that are within tolerance of each other and returns a point remap array: 
+ * for every point number the number of the point it is fused into (the first point of each group). 
+ * Points that are not fused map to themselves.
+ * The positions are sorted into a hashGridStruct, so this takes O(n log n) instead of comparing every pair of points.
+ * If rewire is 1, the vertices of duplicate points are moved to the kept point and the duplicate points are removed.
+ * Rewiring edits the geometry of the first input (0), so run it in a detail wrangle with input 0.
+ * If input is not 0, rewire is ignored with a warning and only the remap is returned.
+ * Primitives that end up with the same point twice are not removed.
+ * The remap uses the point numbers of the input. After rewiring the kept points are renumbered, 
+ * newnumbers contains the number every input point has in the output geometry.
+ * 
+ * @param {int}	{input}  number of the input that we look at to find the geometry
+ * @param {float}	{tolerance}  maximum distance between points that get fused
+ * @param {int}	{rewire}  1 to rewire the vertices and remove the duplicate points, 0 to only return the remap
+ * @param {int array}	{newnumbers}  a variable that is passed by reference. For every input point it will contain the output point number of the point it is fused into.
+ * 
+ * Example:
+ * //Detail wrangle:
+ * int newnumbers[];
+ * i[]@remap = fusepoints(0, 0.001, 1, newnumbers);
+ */
+int[] fusepoints(const int input; const float tolerance; const int rewire; int newnumbers[]){
+	int remap[];
+	resize(newnumbers, 0);
+	int rewirepoints = rewire;
+	if(rewire && input!=0){ //the point and vertex numbers of input would be applied to input 0
+		warning("fusepoints: rewiring only works on input 0, not on input %i. Only the remap is returned.", input);
+		rewirepoints = 0;
+	}
+	vector positions[] = pointsp(input);
+	if(len(positions)==0){
+		return remap;
+	}
+	uniquearray(positions, tolerance, remap); //remap now holds the index of the unique position
+
+	//the first point of each group becomes the kept point, the kept points keep their order in the output
+	int keep[];
+	resize(newnumbers, len(remap));
+	foreach(int pt; int unique; remap){
+		if(unique==len(keep)){
+			append(keep, pt);
+		}
+		remap[pt] = keep[unique];
+		newnumbers[pt] = rewirepoints ? unique : keep[unique];
+	}
+
+	if(rewirepoints){
+		foreach(int pt; int target; remap){
+			if(target==pt){
+				continue;
+			}
+			foreach(int vtx; pointvertices(input, pt)){
+				setvertexpoint(0, -1, vtx, target);
+			}
+			removepoint(0, pt, 0);
+		}
+	}
+	return remap;
+}
+
+/**
+ * Finds points that are within tolerance of each other and returns a point remap array (see fusepoints(input, tolerance, rewire, newnumbers)).
+ * The remap uses the point numbers of the input, after rewiring they do not match the output geometry anymore.
+ * 
+ * @param {int}	{input}  number of the input that we look at to find the geometry
+ * @param {float}	{tolerance}  maximum distance between points that get fused
+ * @param {int}	{rewire}  1 to rewire the vertices and remove the duplicate points, 0 to only return the remap
+ * 
+ * Example:
+ * //Detail wrangle:
+ * i[]@remap = fusepoints(0, 0.001, 1);
+ */
+int[] fusepoints(const int input; const float tolerance; const int rewire){
+	int newnumbers[];
+	return fusepoints(input, tolerance, rewire, newnumbers);
+}
+
+
+/**
+ * Calculates the mean and gaussian curvature of a point from its one-ring and writes them into mean and gauss.
+ * Every primitive of the point is read once with primpoints(), the corner at the point is used as a triangle 
+ * (the point and its previous and next point on the primitive). 
+ * The mean curvature uses cotangent weights, the gaussian curvature the angle defect, both divided by a third of the one-ring area.
+ * The mean curvature is positive where the surface bends away from the primitive normals (like a sphere with normals pointing out).
+ * Points on a boundary use PI instead of 2*PI for the angle defect, their mean curvature is only an estimate.
+ * Returns 1 on success, 0 if the point has no primitives or no area.
+ * 
+ * @param {int}	{input}  number of the input that we look at to find the geometry
+ * @param {int}	{ptnum}  point number
+ * @param {float}	{mean}  a variable that is passed by reference. It will contain the mean curvature.
+ * @param {float}	{gauss}  a variable that is passed by reference. It will contain the gaussian curvature.
+ * 
+ * Example:
+ * //Point wrangle:
+ * curvatures(0, @ptnum, f@curvature_mean, f@curvature_gauss);
+ */
+int curvatures(const int input; const int ptnum; float mean, gauss){
+	mean = 0;
+	gauss = 0;
+	vector P = point(input, "P", ptnum);
+	vector laplace = 0; //sum of cotangent weighted edge vectors
+	vector normal = 0;
+	float area = 0;
+	float anglesum = 0;
+	int ring[]; //previous and next point of every corner. Inside a mesh every neighbour shows up twice.
+	foreach(int prim; pointprims(input, ptnum)){
+		int pts[] = primpoints(input, prim);
+		int amount = len(pts);
+		int index = find(pts, ptnum);
+		if(amount<3 || index<0){
+			continue;
+		}
+		int prev = pts[(index+amount-1)%amount];
+		int next = pts[(index+1)%amount];
+		append(ring, prev);
+		append(ring, next);
+		vector Pp = point(input, "P", prev);
+		vector Pn = point(input, "P", next);
+		vector toprev = Pp-P;
+		vector tonext = Pn-P;
+		float area2 = length(cross(toprev, tonext)); //twice the triangle area
+		if(area2<=0){
+			continue;
+		}
+		anglesum += atan2(area2, dot(toprev, tonext));
+		area += area2*.5;
+		//the angle at prev weights the edge to next, the angle at next weights the edge to prev
+		float cotprev = dot(-toprev, Pn-Pp)/area2;
+		float cotnext = dot(-tonext, Pp-Pn)/area2;
+		laplace += cotprev*(-tonext) + cotnext*(-toprev);
+		normal += prim_normal(input, prim, .5, .5);
+	}
+	if(area<=0){
+		return 0;
+	}
+	area /= 3.0; //barycentric area of the point
+	int boundary = 0;
+	ring = sort(ring);
+	for(int i=0; i<len(ring); i+=2){
+		if(ring[i]!=ring[i+1]){ //a neighbour that only one corner touches
+			boundary = 1;
+			break;
+		}
+	}
+	gauss = ( (boundary ? PI : 2*PI) - anglesum )/area;
+	laplace /= 2*area;
+	mean = .5*length(laplace);
+	if(dot(laplace, normal)<0){
+		mean = -mean;
+	}
+	return 1;
+}
+
+/**
+ * Calculates the mean and gaussian curvature of a point (see curvatures()) and writes them to the 
+ * point attributes "curvature_mean" and "curvature_gauss" of the first input (0).
+ * 
+ * @param {int}	{input}  number of the input that we look at to find the geometry
+ * @param {int}	{ptnum}  point number
+ * 
+ * Example:
+ * //Point wrangle:
+ * setcurvatures(0, @ptnum);
+ */
+void setcurvatures(const int input; const int ptnum){
+	float mean, gauss;
+	curvatures(input, ptnum, mean, gauss);
+	setpointattrib(0, "curvature_mean", ptnum, mean, "set");
+	setpointattrib(0, "curvature_gauss", ptnum, gauss, "set");
+}
 
 #endif
@@ -0,0 +1,459 @@
+#ifndef __easyVexGrids_h__
+#define __easyVexGrids_h__
+
+/**
+ * Spatial grid struct and functions for fast neighbour queries on vector arrays.
+ */
+
+/**
+ * Returns the index of the first element in a sorted int array that is not smaller than value.
+ * Returns len(sorted) if every element is smaller than value.
+ * This is a binary search, so it takes O(log n) instead of the O(n) of find().
+ *
+ * @param {int array}	{sorted}   int array sorted in ascending order
+ * @param {int}	{value}   value to search for
+ *
+ * Example:
+ * int testIntArray[] = {1,3,3,7};
+ * i@index = lowerbound(testIntArray,3); //1
+ * i@index2 = lowerbound(testIntArray,4); //3
+ */
+function int lowerbound(const int sorted[]; const int value){
+	int lo = 0;
+	int hi = len(sorted);
+	while(lo<hi){
+		int mid = (lo+hi)/2;
+		if(sorted[mid]<value){
+			lo = mid+1;
+		}
+		else{
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+/**
+ * Returns the index of value in a sorted int array or -1 if the value is not in the array.
+ * Works like find(), but uses a binary search. The array has to be sorted in ascending order!
+ *
+ * @param {int array}	{sorted}   int array sorted in ascending order
+ * @param {int}	{value}   value to search for
+ *
+ * Example:
+ * int testIntArray[] = {1,3,3,7};
+ * i@index = findsorted(testIntArray,7); //3
+ * i@index2 = findsorted(testIntArray,4); //-1
+ */
+function int findsorted(const int sorted[]; const int value){
+	int index = lowerbound(sorted, value);
+	if(index<len(sorted) && sorted[index]==value){
+		return index;
+	}
+	return -1;
+}
+
+/**
+ * \verbatim
+ * A hashGridStruct sorts an array of positions into a uniform grid of cubic cells,
+ * so proximity queries only have to look at the cells around a position instead of every position.
+ * Only occupied cells are stored. Every cell has a key (its linear cell index) and the keys are kept sorted,
+ * so finding a cell is a binary search and the positions of a cell are one contiguous range in order[].
+ *
+ * The grid never has more than 1024 cells per axis. If the requested cell size is smaller than that allows,
+ * the cell size is increased. Queries stay correct, they just test more candidates.
+ *
+ * To create a grid:
+ * 	vector positions[] = {{0,0,0},{0.05,0,0},{1,0,0}};
+ * 	hashGridStruct grid = hashGridStruct(positions, 0.1);
+ *
+ * To build a grid from the points of a geometry input:
+ * 	hashGridStruct grid = hashGridStruct(pointsp(0), 0.1);
+ *
+ * To find all positions within a radius:
+ * 	int found[] = radiuspoints(grid, {0,0,0}, 0.1); //{0,1}
+ *
+ * To find the closest positions:
+ * 	int nearest = nearpoint(grid, {0.9,0,0}); //2
+ * 	int nearest4[] = nearpoints(grid, {0.9,0,0}, 1.0, 4); //{2,1,0}
+ *
+ * To find all pairs of positions that are within a radius of each other:
+ * 	int pairs[] = nearpairs(grid, 0.1); //{0,1}
+ * \endverbatim
+ */
+struct hashGridStruct{
+	vector origin; //minimum corner of the grid
+	float cellsize; //edge length of a cell
+	int resx,resy,resz; //amount of cells per axis
+	vector positions[]; //positions the grid was built from
+	int cellkeys[]; //sorted keys of all occupied cells
+	int cellstarts[]; //offset into order for every occupied cell, followed by len(order)
+	int order[]; //indices into positions, grouped by cell
+
+	/**
+	 * Returns the amount of positions stored in the grid
+	 *
+	 * Example: int amount = npoints(grid);
+	 */
+	int npoints(){
+		return len(this.positions);
+	}
+
+	/**
+	 * Returns the position with the given index
+	 *
+	 * @param {int}	{index}   index into the array the grid was built from
+	 *
+	 * Example: vector pos = pointp(grid,0);
+	 */
+	vector pointp(const int index){
+		return this.positions[index];
+	}
+
+	/**
+	 * Returns the key of the cell with the cell coordinates x, y and z
+	 *
+	 * @param {int}	{x}   cell coordinate
+	 * @param {int}	{y}   cell coordinate
+	 * @param {int}	{z}   cell coordinate
+	 *
+	 * Example: int key = cellkey(grid,0,1,0);
+	 */
+	int cellkey(const int x,y,z){
+		return x + this.resx*(y + this.resy*z);
+	}
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////hashGridStruct defintion end. Following are functions using hashGridStructs///////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Writes the cell coordinates of a position into x, y and z.
+ * The coordinates can be outside of the grid, if the position is outside of the grid.
+ *
+ * @param {hashGridStruct}	{grid}   a hashGridStruct
+ * @param {vector}	{pos}   a position
+ * @param {int}	{x}   a variable that is passed by reference. It will contain the cell coordinate along x
+ * @param {int}	{y}   a variable that is passed by reference. It will contain the cell coordinate along y
+ * @param {int}	{z}   a variable that is passed by reference. It will contain the cell coordinate along z
+ */
+void gridcell(const hashGridStruct grid; const vector pos; int x,y,z){
+	vector cell = floor( (pos-grid.origin)/grid.cellsize );
+	x = int(cell.x);
+	y = int(cell.y);
+	z = int(cell.z);
+}
+
+/**
+ * Returns 1 if the cell x, y, z is occupied and writes the range of its entries in order[] into start and end.
+ * Returns 0 if the cell is empty or outside of the grid.
+ *
+ * @param {hashGridStruct}	{grid}   a hashGridStruct
+ * @param {int}	{x}   cell coordinate
+ * @param {int}	{y}   cell coordinate
+ * @param {int}	{z}   cell coordinate
+ * @param {int}	{start}   a variable that is passed by reference. First slot of the cell in order[]
+ * @param {int}	{end}   a variable that is passed by reference. One past the last slot of the cell in order[]
+ */
+int gridcellrange(const hashGridStruct grid; const int x,y,z; int start,end){
+	start = 0;
+	end = 0;
+	if(x<0 || y<0 || z<0 || x>=grid.resx || y>=grid.resy || z>=grid.resz){
+		return 0;
+	}
+	int index = findsorted(grid.cellkeys, cellkey(grid,x,y,z) );
+	if(index<0){
+		return 0;
+	}
+	start = grid.cellstarts[index];
+	end = grid.cellstarts[index+1];
+	return 1;
+}
+
+/**
+ * Returns a hashGridStruct built from an array of positions.
+ * Building takes one pass over the positions and one sort.
+ *
+ * @param {vector array}	{positions}   arbitrary vector array
+ * @param {float}	{cellsize}   requested edge length of a cell. Should be about the size of your query radius. 
+ *                             	If it is 0 or smaller, the cell size is chosen so there is about one position per cell.
+ *
+ * Example: hashGridStruct grid = hashGridStruct(positions, 0.1);
+ */
+hashGridStruct hashGridStruct(const vector positions[]; const float cellsize){
+	hashGridStruct grid;
+	int amount = len(positions);
+	vector bmin = {0,0,0};
+	vector bmax = {0,0,0};
+	if(amount>0){
+		bmin = positions[0];
+		bmax = positions[0];
+	}
+	foreach(vector pos; positions){
+		bmin = min(bmin,pos);
+		bmax = max(bmax,pos);
+	}
+	vector size = bmax-bmin;
+	float extent = max( size.x, max(size.y,size.z) );
+	float cell = cellsize;
+	if(cell<=0){ //automatic: about one position per cell
+		cell = extent/max( ceil( pow(float(amount), 1.0/3.0) ), 1.0 );
+	}
+	cell = max(cell, extent/1023.0); //never more than 1024 cells per axis, so keys fit into an int
+	if(cell<=0){ //all positions are the same or no cell size was given
+		cell = 1.0;
+	}
+
+	grid.origin = bmin;
+	grid.cellsize = cell;
+	grid.resx = min( int(floor(size.x/cell))+1, 1024);
+	grid.resy = min( int(floor(size.y/cell))+1, 1024);
+	grid.resz = min( int(floor(size.z/cell))+1, 1024);
+	grid.positions = positions;
+
+	//key of every position
+	int keys[];
+	resize(keys, amount);
+	int x,y,z;
+	foreach(int i; vector pos; positions){
+		gridcell(grid,pos,x,y,z);
+		keys[i] = cellkey(grid, clamp(x,0,grid.resx-1), clamp(y,0,grid.resy-1), clamp(z,0,grid.resz-1) );
+	}
+
+	//group positions by cell
+	int order[] = argsort(keys);
+	int cellkeys[];
+	int cellstarts[];
+	int previous = -1;
+	foreach(int slot; int index; order){
+		if(keys[index]!=previous){
+			previous = keys[index];
+			append(cellkeys, previous);
+			append(cellstarts, slot);
+		}
+	}
+	append(cellstarts, amount);
+
+	grid.order = order;
+	grid.cellkeys = cellkeys;
+	grid.cellstarts = cellstarts;
+	return grid;
+}
+
+/**
+ * Returns the indices of all positions in the grid that are within radius of pos (unsorted).
+ *
+ * @param {hashGridStruct}	{grid}   a hashGridStruct
+ * @param {vector}	{pos}   position that we examine
+ * @param {float}	{radius}   search radius
+ *
+ * Example: i[]@found = radiuspoints(grid, v@P, 0.1);
+ */
+int[] radiuspoints(const hashGridStruct grid; const vector pos; const float radius){
+	int result[];
+	int x0,y0,z0,x1,y1,z1,start,end;
+	vector offset = set(radius,radius,radius);
+	gridcell(grid, pos-offset, x0,y0,z0);
+	gridcell(grid, pos+offset, x1,y1,z1);
+	for(int z=max(z0,0); z<=min(z1,grid.resz-1); z++){
+		for(int y=max(y0,0); y<=min(y1,grid.resy-1); y++){
+			for(int x=max(x0,0); x<=min(x1,grid.resx-1); x++){
+				if( !gridcellrange(grid,x,y,z,start,end) ){
+					continue;
+				}
+				for(int slot=start; slot<end; slot++){
+					int index = grid.order[slot];
+					if( distance(grid.positions[index],pos)<=radius ){
+						append(result,index);
+					}
+				}
+			}
+		}
+	}
+	return result;
+}
+
+/**
+ * Returns the indices of all positions in the cells that are exactly ring cells away from cell cx, cy, cz 
+ * (the hollow shell of a cube of cells). Ring 0 is the cell itself. Cells outside of the grid are skipped.
+ *
+ * @param {hashGridStruct}	{grid}   a hashGridStruct
+ * @param {int}	{cx}   cell coordinate of the center cell
+ * @param {int}	{cy}   cell coordinate of the center cell
+ * @param {int}	{cz}   cell coordinate of the center cell
+ * @param {int}	{ring}   distance in cells from the center cell
+ */
+int[] gridring(const hashGridStruct grid; const int cx,cy,cz,ring){
+	int result[];
+	int start,end;
+	for(int z=max(cz-ring,0); z<=min(cz+ring,grid.resz-1); z++){
+		for(int y=max(cy-ring,0); y<=min(cy+ring,grid.resy-1); y++){
+			int fullrow = abs(z-cz)==ring || abs(y-cy)==ring; //otherwise only the first and last cell of the row are on the ring
+			for(int x=max(cx-ring,0); x<=min(cx+ring,grid.resx-1); x++){
+				if(!fullrow && abs(x-cx)!=ring){
+					x = cx+ring-1; //skip to the last cell of the row
+					continue;
+				}
+				if( !gridcellrange(grid,x,y,z,start,end) ){
+					continue;
+				}
+				append(result, grid.order[start:end]);
+			}
+		}
+	}
+	return result;
+}
+
+/**
+ * Writes the first and the last ring that a search around cell cx, cy, cz has to visit to cover the whole grid.
+ *
+ * @param {hashGridStruct}	{grid}   a hashGridStruct
+ * @param {int}	{cx}   cell coordinate of the center cell
+ * @param {int}	{cy}   cell coordinate of the center cell
+ * @param {int}	{cz}   cell coordinate of the center cell
+ * @param {int}	{firstring}   a variable that is passed by reference. The first ring that touches the grid.
+ * @param {int}	{lastring}   a variable that is passed by reference. The ring that reaches the furthest cell.
+ */
+void gridrings(const hashGridStruct grid; const int cx,cy,cz; int firstring,lastring){
+	firstring = max( 0, max( max(-cx, cx-grid.resx+1), max( max(-cy, cy-grid.resy+1), max(-cz, cz-grid.resz+1) ) ) );
+	lastring = max( max( abs(cx), abs(cx-grid.resx+1) ), max( max( abs(cy), abs(cy-grid.resy+1) ), max( abs(cz), abs(cz-grid.resz+1) ) ) );
+}
+
+/**
+ * Returns the index of the position in the grid that is closest to pos and not further away than maxdist. 
+ * Returns -1 if there is no such position.
+ * The search visits rings of cells around pos and stops as soon as no closer position can exist.
+ *
+ * @param {hashGridStruct}	{grid}   a hashGridStruct
+ * @param {vector}	{pos}   position that we examine
+ * @param {float}	{maxdist}   maximum search distance
+ *
+ * Example: i@nearest = nearpoint(grid, v@P, 1.0);
+ */
+int nearpoint(const hashGridStruct grid; const vector pos; const float maxdist){
+	int nearest = -1;
+	float nearestdist = maxdist;
+	int cx,cy,cz,firstring,lastring;
+	gridcell(grid,pos,cx,cy,cz);
+	gridrings(grid,cx,cy,cz,firstring,lastring);
+	for(int ring=firstring; ring<=lastring; ring++){
+		if( (ring-1)*grid.cellsize>nearestdist ){ //every position in this ring is further away
+			break;
+		}
+		foreach(int index; gridring(grid,cx,cy,cz,ring) ){
+			float dist = distance(grid.positions[index],pos);
+			if( dist<=maxdist && (nearest<0 || dist<nearestdist) ){
+				nearest = index;
+				nearestdist = dist;
+			}
+		}
+	}
+	return nearest;
+}
+
+/**
+ * Returns the index of the position in the grid that is closest to pos. Returns -1 if the grid is empty.
+ *
+ * @param {hashGridStruct}	{grid}   a hashGridStruct
+ * @param {vector}	{pos}   position that we examine
+ *
+ * Example: i@nearest = nearpoint(grid, v@P);
+ */
+int nearpoint(const hashGridStruct grid; const vector pos){
+	return nearpoint(grid, pos, 1e30);
+}
+
+/**
+ * Returns the indices of the maxpts closest positions within maxdist of pos, sorted by distance (closest first).
+ *
+ * @param {hashGridStruct}	{grid}   a hashGridStruct
+ * @param {vector}	{pos}   position that we examine
+ * @param {float}	{maxdist}   maximum search distance
+ * @param {int}	{maxpts}   maximum amount of positions to return
+ *
+ * Example: i[]@nearest = nearpoints(grid, v@P, 1.0, 4);
+ */
+int[] nearpoints(const hashGridStruct grid; const vector pos; const float maxdist; const int maxpts){
+	int found[];
+	float dists[];
+	if(maxpts<1){
+		return found;
+	}
+	int cx,cy,cz,firstring,lastring;
+	gridcell(grid,pos,cx,cy,cz);
+	gridrings(grid,cx,cy,cz,firstring,lastring);
+	for(int ring=firstring; ring<=lastring; ring++){
+		if( (ring-1)*grid.cellsize>maxdist ){
+			break;
+		}
+		if( len(dists)>=maxpts ){
+			float sorted[] = sort(dists);
+			if( (ring-1)*grid.cellsize>sorted[maxpts-1] ){ //enough positions that are closer than this ring
+				break;
+			}
+		}
+		foreach(int index; gridring(grid,cx,cy,cz,ring) ){
+			float dist = distance(grid.positions[index],pos);
+			if(dist<=maxdist){
+				append(found,index);
+				append(dists,dist);
+			}
+		}
+	}
+	found = reorder( found, argsort(dists) );
+	return found[0:maxpts];
+}
+
+/**
+ * Returns all pairs of positions that are within radius of each other as an int array 
+ * where every two numbers are the indices of one pair (the smaller index first).
+ * Every occupied cell is only compared to itself and to the neighbouring cells in one half of the directions,
+ * so every pair is tested once.
+ *
+ * @param {hashGridStruct}	{grid}   a hashGridStruct
+ * @param {float}	{radius}   maximum distance between the positions of a pair
+ *
+ * Example: i[]@pairs = nearpairs(grid, 0.1);
+ */
+int[] nearpairs(const hashGridStruct grid; const float radius){
+	int result[];
+	int reach = max( int(ceil(radius/grid.cellsize)), 0 ); //amount of neighbouring cells to compare to per axis
+	int start,end,otherstart,otherend;
+	foreach(int cell; int key; grid.cellkeys){
+		int x = key%grid.resx;
+		int y = (key/grid.resx)%grid.resy;
+		int z = key/(grid.resx*grid.resy);
+		start = grid.cellstarts[cell];
+		end = grid.cellstarts[cell+1];
+		for(int dz=0; dz<=reach; dz++){
+			for(int dy=(dz==0 ? 0 : -reach); dy<=reach; dy++){
+				for(int dx=(dz==0 && dy==0 ? 0 : -reach); dx<=reach; dx++){
+					int samecell = dx==0 && dy==0 && dz==0;
+					if( !samecell && !gridcellrange(grid,x+dx,y+dy,z+dz,otherstart,otherend) ){
+						continue;
+					}
+					if(samecell){
+						otherstart = start;
+						otherend = end;
+					}
+					for(int slot=start; slot<end; slot++){
+						int index = grid.order[slot];
+						vector pos = grid.positions[index];
+						for(int otherslot=(samecell ? slot+1 : otherstart); otherslot<otherend; otherslot++){
+							int otherindex = grid.order[otherslot];
+							if( distance(grid.positions[otherindex],pos)<=radius ){
+								append(result, min(index,otherindex) );
+								append(result, max(index,otherindex) );
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+	return result;
+}
+
+#endif
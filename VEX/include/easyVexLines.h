@@ -152,6 +152,25 @@ lineStruct lineStruct(const int input; const edgeStruct edge; const int type){
 	return line;
 }
 
+/**
+ * Returns a line struct from an edgeGeoStruct, of type 0 (closed). Uses the stored positions.
+ *
+ * @param {edgeGeoStruct}	{edge}   an edgeGeoStruct
+ */
+lineStruct lineStruct(const edgeGeoStruct edge){
+	return lineStruct(posa(edge),posb(edge),0);
+}
+
+/**
+ * Returns a line struct from an edgeGeoStruct, of type. Uses the stored positions.
+ *
+ * @param {edgeGeoStruct}	{edge}   an edgeGeoStruct
+ * @param {int}	{type}	an integer indicating the type of the lineStruct (see lineStruct types)
+ */
+lineStruct lineStruct(const edgeGeoStruct edge; const int type){
+	return lineStruct(posa(edge),posb(edge),type);
+}
+
 /**
  * Returns minimum distance between a lineStruct and pos X 
  * http://mathworld.wolfram.com/Point-LineDistance3-Dimensional.html
@@ -395,12 +414,675 @@ function float angle_d(const lineStruct l1,l2){
 	return degrees( acos( dot(u,v)  ) );
 }
 
+/**
+ * Returns the parameter t clamped to the range of a line type. t is 0 at A and 1 at B.
+ * 
+ * lineStruct types:
+ * (0) a line-segment: 0 to 1
+ * (1) an infinite line: not clamped
+ * (2) a line starting at B and extending (infinitely) in direction A: up to 1
+ * (3) a line starting at A and extending (infinitely) in direction B: from 0
+ *
+ * @param {int}	{type}	an integer indicating the type of a lineStruct
+ * @param {float}	{t}	a parameter along a line
+ */
+float clampparam(const int type; const float t){
+	if(type==1){
+		return t;
+	}
+	if(type==2){
+		return min(t,1.0);
+	}
+	if(type==3){
+		return max(t,0.0);
+	}
+	return clamp(t,0.0,1.0);
+}
+
+/**
+ * Returns the parameter t of the closest position on a lineStruct to pos X. t is 0 at A and 1 at B.
+ * Returns 0 if A and B are the same.
+ *
+ * @param {lineStruct}	{line}	a lineStruct
+ * @param {vector}	{X}	a position
+ *
+ * Example: vector closest = lerp(posa(line), posb(line), closestparam(line, v@P));
+ */
+float closestparam(const lineStruct line; const vector X){
+	vector AB = vectorab(line);
+	float length2 = dot(AB,AB);
+	return length2>0 ? clampparam( type(line), dot(X-posa(line),AB)/length2 ) : 0.0;
+}
+
+/**
+ * Returns the closest position on a lineStruct to pos X
+ *
+ * @param {lineStruct}	{line}	a lineStruct
+ * @param {vector}	{X}	a position
+ */
+vector closestpos(const lineStruct line; const vector X){
+	return posa(line) + vectorab(line)*closestparam(line,X);
+}
+
+/////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////
+//Following is a line that stores its direction (preparedLineStruct)//
+/////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////
+
+/**
+ * \verbatim
+ * A preparedLineStruct is a lineStruct that stores its normalized direction, length and inverse length. 
+ * They are calculated once when it is created, so the line functions do not normalize or divide again.
+ * Use it instead of a lineStruct when you test many positions against the same lines.
+ * If you change A or B afterwards, create a new preparedLineStruct.
+ *
+ * To create a variable of type custom struct:
+ * 	preparedLineStruct line1 = preparedLineStruct( set(0,0,0), set(1,0,0), 0);
+ * 	preparedLineStruct line2 = preparedLineStruct( lineStruct(edge) );
+ *
+ * To use it:
+ * 	f@dist = distance(line1, v@P);
+ * \endverbatim
+ */
+struct preparedLineStruct{
+	vector A,B; //point A and B on a line 
+	int type; //see lineStruct types
+	vector dir; //normalized vector AB
+	float length; //distance between A and B
+	float invlength; //1/length or 0 if A==B
+
+	/**
+ 	 * Returns point A position on line
+ 	 *
+ 	 * Example: vector positiona = posa(line1);
+ 	 */
+	vector posa(){
+		return this.A;
+	}
+
+	/**
+ 	 * Returns point B position on line
+ 	 *
+  	 * Example: vector positionb = posb(line1);
+ 	 */
+	vector posb(){
+		return this.B;
+	}
+
+	/**
+	 * Returns type of line (see lineStruct types)
+ 	 *
+ 	 * Example: int lineType = type(line1);
+	 */
+	int type(){
+		return this.type;
+	}
+
+	/**
+ 	 * Returns the stored normalized vector AB
+ 	 *
+ 	 * Example: vector dir_n = vectorab_n(line1);
+ 	 */
+	vector vectorab_n(){
+		return this.dir;
+	}
+
+	/**
+ 	 * Returns vector AB
+ 	 *
+ 	 * Example: vector dir = vectorab(line1);
+ 	 */
+	vector vectorab(){
+		return this.B-this.A;
+	}
+
+	/**
+ 	 * Returns the stored distance between A and B
+ 	 *
+ 	 * Example: float len = length(line1);
+ 	 */
+	float length(){
+		return this.length;
+	}
+
+	/**
+ 	 * Returns 1 if A and B are NOT the same and otherwise returns 0. 
+ 	 *
+ 	 * Example: int verification = verify(line1);
+ 	 */
+	int verify(){
+		return this.length>0 ? 1 : 0; 
+	}
+}
+
+/**
+ * Returns a preparedLineStruct through positions A and B of a type (see lineStruct types)
+ *
+ * @param {vector}	{A}	a position
+ * @param {vector}	{B}	a position
+ * @param {int}	{type}	an integer indicating the type of the line
+ */
+preparedLineStruct preparedLineStruct(const vector A,B; const int type){
+	float dist = distance(A,B);
+	float invlength = dist>0 ? 1.0/dist : 0.0;
+	return preparedLineStruct(A,B,type,(B-A)*invlength,dist,invlength);
+}
+
+/**
+ * Returns a preparedLineStruct of a lineStruct
+ *
+ * @param {lineStruct}	{line}	a lineStruct
+ */
+preparedLineStruct preparedLineStruct(const lineStruct line){
+	return preparedLineStruct(posa(line),posb(line),type(line));
+}
+
+/**
+ * Returns a preparedLineStruct array of a lineStruct array
+ *
+ * @param {lineStruct array}	{lines}	an array of lineStructs
+ */
+preparedLineStruct[] preparedlinestructs(const lineStruct lines[]){
+	preparedLineStruct result[];
+	resize(result,len(lines));
+	foreach(int i; lineStruct line; lines){
+		result[i] = preparedLineStruct(line);
+	}
+	return result;
+}
+
+/**
+ * Returns the lineStruct of a preparedLineStruct
+ *
+ * @param {preparedLineStruct}	{line}	a preparedLineStruct
+ */
+lineStruct lineStruct(const preparedLineStruct line){
+	return lineStruct(posa(line),posb(line),type(line));
+}
+
+/**
+ * Returns the parameter t of the closest position on a preparedLineStruct to pos X. t is 0 at A and 1 at B.
+ *
+ * @param {preparedLineStruct}	{line}	a preparedLineStruct
+ * @param {vector}	{X}	a position
+ */
+float closestparam(const preparedLineStruct line; const vector X){
+	return clampparam( line.type, dot(X-line.A,line.dir)*line.invlength );
+}
+
+/**
+ * Returns the closest position on a preparedLineStruct to pos X
+ *
+ * @param {preparedLineStruct}	{line}	a preparedLineStruct
+ * @param {vector}	{X}	a position
+ */
+vector closestpos(const preparedLineStruct line; const vector X){
+	return line.A + line.dir*( closestparam(line,X)*line.length );
+}
+
+/**
+ * Returns minimum distance between a preparedLineStruct and pos X.
+ * Projects X onto the stored direction and clamps it to the line type, so there is no division.
+ *
+ * @param {preparedLineStruct}	{line}	a preparedLineStruct
+ * @param {vector}	{X}	a position
+ */
+float distance(const preparedLineStruct line; const vector X){
+	return distance( X, closestpos(line,X) );
+}
+
+/**
+ * Returns 1 or 2 if both lines share the same direction (otherwise 0). Uses the stored directions.
+ *
+ * Returns == 2 -> directions for l1 and l2 are exactly the same
+ * Returns == 1 -> directions for l1 and l2 are exactly the same, but reversed
+ * Returns == 0 -> one or more directions are different
+ * 
+ * @param {preparedLineStruct}	{l1}	a preparedLineStruct
+ * @param {preparedLineStruct}	{l2}	a preparedLineStruct
+ */
+int samedirections(const preparedLineStruct l1,l2){
+	float threshold = 0.0001;
+	if( length( l1.dir - l2.dir)<threshold ){
+		return 2;
+	}
+	if( length(-l1.dir - l2.dir)<threshold ){
+		return 1;
+	}
+	return 0;
+}
+
+/**
+ * Returns 1 if both lines are on the same infinite line (otherwise 0). Uses the stored directions.
+ *
+ * @param {preparedLineStruct}	{l1}	a preparedLineStruct
+ * @param {preparedLineStruct}	{l2}	a preparedLineStruct
+ */
+int sameline(const preparedLineStruct l1,l2){
+	float threshold = 0.0001;
+	if( samedirections(l1,l2) ){
+		vector AX = l2.A - l1.A;
+		if( length( AX - l1.dir*dot(AX,l1.dir) )<threshold ){
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Returns the angle between two lines in degrees. Uses the stored directions.
+ * 
+ * @param {preparedLineStruct}	{l1}  a preparedLineStruct
+ * @param {preparedLineStruct}	{l2}  a preparedLineStruct
+ */
+function float angle_d(const preparedLineStruct l1,l2){
+	return degrees( acos( clamp( dot(l1.dir,l2.dir), -1.0, 1.0 ) ) );
+}
+
+/////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////
+//Following is a tree to find the closest of many lines (lineBVHStruct)//
+/////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////
+
+/**
+ * \verbatim
+ * A lineBVHStruct sorts the line-segments of a lineStruct array into a tree of bounding boxes (bounding volume hierarchy).
+ * closestline() only tests the lines of boxes that can be closer than the best line found so far,
+ * so a query takes about O(log n) instead of testing every line.
+ * Lines of type 1, 2 and 3 are infinite and have no bounding box, they are tested for every query.
+ * Create it once (for example in a detail wrangle or with a detail attribute) and query it for many positions.
+ *
+ * To create a variable of type custom struct:
+ * 	lineBVHStruct bvh = lineBVHStruct(lines); //lines is a lineStruct array
+ *
+ * To use it:
+ * 	float dist, t;
+ * 	i@line = closestline(bvh, v@P, dist, t);
+ * \endverbatim
+ */
+struct lineBVHStruct{
+	vector A[]; //point A of every line
+	vector B[]; //point B of every line
+	int types[]; //type of every line
+	int order[]; //line-segments (type 0) sorted by tree node. Every leaf has a range in order.
+	int unbounded[]; //lines of type 1,2,3. They are not in the tree.
+	vector nodemin[]; //minimum of the bounding box of every node
+	vector nodemax[]; //maximum of the bounding box of every node
+	int nodechild[]; //first child of every node, the second child is nodechild+1. -1 for leaves.
+	int nodestart[]; //first index in order of every node
+	int nodecount[]; //amount of lines in order of every node
+
+	/**
+	 * Returns the amount of lines
+	 *
+	 * Example: int amount = nlines(bvh);
+	 */
+	int nlines(){
+		return len(this.A);
+	}
+
+	/**
+	 * Returns the lineStruct of a line
+	 *
+	 * Example: lineStruct line = line(bvh, 3);
+	 */
+	lineStruct line(const int index){
+		return lineStruct(this.A[index],this.B[index],this.types[index]);
+	}
+}
+
+/**
+ * Returns a lineBVHStruct of an array of lineStructs. See lineBVHStruct.
+ * Nodes are split at the median of the longest side of their bounding box until they hold leafsize lines or less.
+ *
+ * @param {lineStruct array}	{lines}	an array of lineStructs
+ * @param {int}	{leafsize}	maximum amount of lines in a leaf node
+ */
+lineBVHStruct lineBVHStruct(const lineStruct lines[]; const int leafsize){
+	lineBVHStruct bvh;
+	int amount = len(lines);
+	resize(bvh.A, amount);
+	resize(bvh.B, amount);
+	resize(bvh.types, amount);
+	vector centers[];
+	resize(centers, amount);
+	foreach(int i; lineStruct line; lines){
+		bvh.A[i] = posa(line);
+		bvh.B[i] = posb(line);
+		bvh.types[i] = type(line);
+		centers[i] = (bvh.A[i]+bvh.B[i])*.5;
+		if(bvh.types[i]==0){
+			append(bvh.order, i);
+		}
+		else{
+			append(bvh.unbounded, i);
+		}
+	}
+	if(len(bvh.order)==0){
+		return bvh;
+	}
+	int maxleaf = max(leafsize,1);
+	//root node, then split nodes until all leaves are small enough
+	append(bvh.nodestart, 0);
+	append(bvh.nodecount, len(bvh.order));
+	int stack[] = {0};
+	while(len(stack)>0){
+		int node = pop(stack);
+		int start = bvh.nodestart[node];
+		int count = bvh.nodecount[node];
+		vector bmin = min(bvh.A[bvh.order[start]], bvh.B[bvh.order[start]]);
+		vector bmax = max(bvh.A[bvh.order[start]], bvh.B[bvh.order[start]]);
+		vector cmin = centers[bvh.order[start]];
+		vector cmax = cmin;
+		for(int i=start+1; i<start+count; i++){
+			int line = bvh.order[i];
+			bmin = min(bmin, min(bvh.A[line], bvh.B[line]));
+			bmax = max(bmax, max(bvh.A[line], bvh.B[line]));
+			cmin = min(cmin, centers[line]);
+			cmax = max(cmax, centers[line]);
+		}
+		resize(bvh.nodemin, max(len(bvh.nodemin), node+1));
+		resize(bvh.nodemax, max(len(bvh.nodemax), node+1));
+		resize(bvh.nodechild, max(len(bvh.nodechild), node+1));
+		bvh.nodemin[node] = bmin;
+		bvh.nodemax[node] = bmax;
+		bvh.nodechild[node] = -1;
+		vector size = cmax-cmin;
+		if(count<=maxleaf || max(size.x,max(size.y,size.z))<=0){
+			continue;
+		}
+		//sort the lines of the node by their centers along the longest side and split them in half
+		int axis = size.x>=size.y ? (size.x>=size.z ? 0 : 2) : (size.y>=size.z ? 1 : 2);
+		int lines_node[] = bvh.order[start:start+count];
+		float keys[];
+		resize(keys, count);
+		foreach(int i; int line; lines_node){
+			keys[i] = getcomp(centers[line], axis);
+		}
+		lines_node = reorder(lines_node, argsort(keys));
+		foreach(int i; int line; lines_node){
+			bvh.order[start+i] = line;
+		}
+		int child = len(bvh.nodestart);
+		int half = count/2;
+		bvh.nodechild[node] = child;
+		append(bvh.nodestart, start);
+		append(bvh.nodecount, half);
+		append(bvh.nodestart, start+half);
+		append(bvh.nodecount, count-half);
+		append(stack, child);
+		append(stack, child+1);
+	}
+	return bvh;
+}
+
+/**
+ * Returns a lineBVHStruct of an array of lineStructs with up to 4 lines per leaf. See lineBVHStruct.
+ *
+ * @param {lineStruct array}	{lines}	an array of lineStructs
+ */
+lineBVHStruct lineBVHStruct(const lineStruct lines[]){
+	return lineBVHStruct(lines, 4);
+}
+
+/**
+ * Returns the index of the line in a lineBVHStruct that is closest to pos X, or -1 if there is no line.
+ * Respects the line types: segments are searched in the tree, infinite lines and rays are tested directly.
+ *
+ * @param {lineBVHStruct}	{bvh}	a lineBVHStruct
+ * @param {vector}	{X}	a position
+ * @param {float}	{dist}	a variable that is passed by reference. It will contain the distance to the closest line.
+ * @param {float}	{t}	a variable that is passed by reference. It will contain the parameter of the closest position on the line (0 at A, 1 at B).
+ *
+ * Example: 
+ * float dist, t;
+ * int index = closestline(bvh, v@P, dist, t);
+ * v@closest = lerp(bvh.A[index], bvh.B[index], t);
+ */
+int closestline(const lineBVHStruct bvh; const vector X; float dist, t){
+	int result = -1;
+	dist = 1e30;
+	t = 0;
+	foreach(int line; bvh.unbounded){
+		vector AB = bvh.B[line]-bvh.A[line];
+		float length2 = dot(AB,AB);
+		float param = length2>0 ? clampparam( bvh.types[line], dot(X-bvh.A[line],AB)/length2 ) : 0.0;
+		float d = distance(X, bvh.A[line]+AB*param);
+		if(d<dist){
+			dist = d;
+			t = param;
+			result = line;
+		}
+	}
+	if(len(bvh.nodestart)==0){
+		return result;
+	}
+	int stack[] = {0};
+	while(len(stack)>0){
+		int node = pop(stack);
+		//distance to the bounding box is a lower bound for all lines inside
+		if(distance(X, clamp(X, bvh.nodemin[node], bvh.nodemax[node]))>=dist){
+			continue;
+		}
+		int child = bvh.nodechild[node];
+		if(child<0){
+			int start = bvh.nodestart[node];
+			for(int i=start; i<start+bvh.nodecount[node]; i++){
+				int line = bvh.order[i];
+				vector AB = bvh.B[line]-bvh.A[line];
+				float length2 = dot(AB,AB);
+				float param = length2>0 ? clamp( dot(X-bvh.A[line],AB)/length2, 0.0, 1.0 ) : 0.0;
+				float d = distance(X, bvh.A[line]+AB*param);
+				if(d<dist){
+					dist = d;
+					t = param;
+					result = line;
+				}
+			}
+			continue;
+		}
+		//visit the closer child first, so it is pushed last
+		float d0 = distance2(X, clamp(X, bvh.nodemin[child], bvh.nodemax[child]));
+		float d1 = distance2(X, clamp(X, bvh.nodemin[child+1], bvh.nodemax[child+1]));
+		if(d0<d1){
+			append(stack, child+1);
+			append(stack, child);
+		}
+		else{
+			append(stack, child);
+			append(stack, child+1);
+		}
+	}
+	return result;
+}
+
+/////////////////////////////////////////////
+/////////////////////////////////////////////
+//Following are line to line closest points//
+/////////////////////////////////////////////
+/////////////////////////////////////////////
+
+/**
+ * Calculates the parameters s (on l1) and t (on l2) of the closest positions between two lines. Both are 0 at A and 1 at B.
+ * Respects the line types of both lines: s and t are clamped to the range of their type, 
+ * then the other parameter is recalculated for the clamped one and clamped again.
+ * Returns 1 if the closest positions are unique and 0 if the lines are parallel (then one of many closest pairs is returned).
+ * 
+ * @param {lineStruct}	{l1}	a lineStruct
+ * @param {lineStruct}	{l2}	a lineStruct
+ * @param {float}	{s}	a variable that is passed by reference. It will contain the parameter on l1.
+ * @param {float}	{t}	a variable that is passed by reference. It will contain the parameter on l2.
+ */
+int closestparams(const lineStruct l1,l2; float s,t){
+	vector d1 = vectorab(l1);
+	vector d2 = vectorab(l2);
+	vector r = posa(l1)-posa(l2);
+	float a = dot(d1,d1);
+	float e = dot(d2,d2);
+	float f = dot(d2,r);
+	int type1 = type(l1);
+	int type2 = type(l2);
+	s = 0;
+	t = 0;
+	if(a<=0 && e<=0){ //both lines are points
+		return 0;
+	}
+	if(a<=0){ //l1 is a point
+		t = clampparam(type2, f/e);
+		return 0;
+	}
+	float c = dot(d1,r);
+	if(e<=0){ //l2 is a point
+		s = clampparam(type1, -c/a);
+		return 0;
+	}
+	float b = dot(d1,d2);
+	float denom = a*e-b*b;
+	int unique = denom>1e-10*a*e;
+	if(unique){
+		s = clampparam(type1, (b*f-c*e)/denom);
+	}
+	//closest t for s, if it is outside of l2 clamp it and find the closest s for that t
+	float tfree = (b*s+f)/e;
+	t = clampparam(type2, tfree);
+	if(t!=tfree){
+		s = clampparam(type1, (b*t-c)/a);
+	}
+	return unique;
+}
+
+/**
+ * Returns the closest positions between two lines as an array: result[0] is on l1, result[1] is on l2.
+ * Respects the line types of both lines.
+ * 
+ * @param {lineStruct}	{l1}	a lineStruct
+ * @param {lineStruct}	{l2}	a lineStruct
+ * @param {int}	{success}	a variable that is passed by reference. It will be 1 if the lines intersect (closer than 0.0001), otherwise 0.
+ *
+ * Example: 
+ * int success;
+ * vector closest[] = closestpoints(l1, l2, success);
+ */
+vector[] closestpoints(const lineStruct l1,l2; int success){
+	float s,t;
+	closestparams(l1,l2,s,t);
+	vector result[];
+	resize(result,2);
+	result[0] = posa(l1) + vectorab(l1)*s;
+	result[1] = posa(l2) + vectorab(l2)*t;
+	float threshold = 0.0001;
+	success = distance(result[0],result[1])<threshold;
+	return result;
+}
+
+/**
+ * Returns the intersection position of two lines. 
+ * If they do not intersect, it returns the position in the middle of the closest positions.
+ * 
+ * @param {lineStruct}	{l1}	a lineStruct
+ * @param {lineStruct}	{l2}	a lineStruct
+ * @param {int}	{success}	a variable that is passed by reference. It will be 1 if the lines intersect (closer than 0.0001), otherwise 0.
+ */
+vector intersection(const lineStruct l1,l2; int success){
+	vector closest[] = closestpoints(l1,l2,success);
+	return (closest[0]+closest[1])*.5;
+}
+
+/**
+ * Returns the minimum distance between two lines. Respects the line types of both lines.
+ * 
+ * @param {lineStruct}	{l1}	a lineStruct
+ * @param {lineStruct}	{l2}	a lineStruct
+ */
+float distance(const lineStruct l1,l2){
+	float s,t;
+	closestparams(l1,l2,s,t);
+	return distance( posa(l1) + vectorab(l1)*s, posa(l2) + vectorab(l2)*t );
+}
+
+/**
+ * Returns all pairs of lines in an array that intersect or are not further apart than tolerance.
+ * Every two numbers in the result are the indices of a pair (the smaller index first).
+ * Line-segments (type 0) are sorted by their smallest x position and only compared while their x ranges overlap (sweep and prune).
+ * Lines of type 1,2,3 are infinite and are compared with every other line.
+ * 
+ * @param {lineStruct array}	{lines}	an array of lineStructs
+ * @param {float}	{tolerance}	maximum distance between two lines that counts as touching. With 0, only exactly touching lines are found (floating point errors may hide them).
+ *
+ * Example: i[]@pairs = intersectingpairs(lines, 0.001);
+ */
+int[] intersectingpairs(const lineStruct lines[]; const float tolerance){
+	int result[];
+	int amount = len(lines);
+	float threshold = max(tolerance, 0.0); //used as given, 0 only finds exactly touching lines
+	int segments[];
+	int unbounded[];
+	float starts[];
+	vector bmin[];
+	vector bmax[];
+	resize(bmin, amount);
+	resize(bmax, amount);
+	foreach(int i; lineStruct line; lines){
+		bmin[i] = min(posa(line),posb(line));
+		bmax[i] = max(posa(line),posb(line));
+		if(type(line)==0){
+			append(segments, i);
+			append(starts, bmin[i].x);
+		}
+		else{
+			append(unbounded, i);
+		}
+	}
+
+	//sweep along x: active holds the segments whose x range can still overlap the next ones
+	segments = reorder(segments, argsort(starts));
+	int active[];
+	foreach(int i; segments){
+		int keep = 0;
+		foreach(int j; active){
+			if(bmax[j].x+threshold<bmin[i].x){ //j ends before i starts, so it ends before all following segments
+				continue;
+			}
+			active[keep] = j;
+			keep++;
+			if( bmax[j].y+threshold<bmin[i].y || bmax[i].y+threshold<bmin[j].y ||
+				bmax[j].z+threshold<bmin[i].z || bmax[i].z+threshold<bmin[j].z ){
+				continue;
+			}
+			if(distance(lines[i],lines[j])<=threshold){
+				append(result, min(i,j));
+				append(result, max(i,j));
+			}
+		}
+		resize(active, keep);
+		append(active, i);
+	}
+
+	//infinite lines against everything else
+	foreach(int k; int i; unbounded){
+		foreach(int j; segments){
+			if(distance(lines[i],lines[j])<=threshold){
+				append(result, min(i,j));
+				append(result, max(i,j));
+			}
+		}
+		for(int n=k+1; n<len(unbounded); n++){
+			int j = unbounded[n];
+			if(distance(lines[i],lines[j])<=threshold){
+				append(result, min(i,j));
+				append(result, max(i,j));
+			}
+		}
+	}
+	return result;
+}
+
 ////////////////////////////////////////
 ////////////////////////////////////////
 ///////////////do this//////////////////
 ////////////////////////////////////////
-//to do: line to line has intersection point?
-//to do: line to line intersection point or closest point (with success parameter)
 //to do: angle around and angle around_d for lines
 
 #endif